@@ -0,0 +1,553 @@
+// alt.cc
+//     Landmark selection, distance tables and the table file for ALT
+//     (see alt.h).
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "alt.h"
+
+#define ALT_PI              3.14159265358979323846
+
+int altFindMethod(const char *name)
+{
+  if (strcmp(name, "avoid") == 0)    return ALT_AVOID;
+  if (strcmp(name, "farthest") == 0) return ALT_FARTHEST;
+  if (strcmp(name, "planar") == 0)   return ALT_PLANAR;
+  return 0;
+}
+
+static FILE *altOpen(const char *fileName, const char *how)
+{
+  FILE *file = fopen(fileName, how);
+
+  if (file == NULL) {
+    fprintf(stderr, "ERROR: can't open landmark file %s\n", fileName);
+    exit(1);
+  }
+  return file;
+}
+
+static void altReadError(const char *fileName, const char *message)
+{
+  fprintf(stderr, "ERROR: landmark file %s: %s\n", fileName, message);
+  exit(1);
+}
+
+bool altWideTables(CSRGraph *graph, SPParams *params)
+{
+  long long maxArcLen;
+  char magic[4];
+  int version, width;
+  FILE *file;
+
+  if (params->altMethod) {
+    ArcLen(graph, NULL, &maxArcLen);
+    return (double) maxArcLen * (double) (graph->n - 1) >= 4294967295.0;
+  }
+  if (params->altFile == NULL) {
+    fprintf(stderr, "ERROR: alt needs a landmark file or a selection method\n");
+    exit(1);
+  }
+  file = altOpen(params->altFile, "rb");
+  if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "ALT", 4) != 0 ||
+      fread(&version, sizeof(int), 1, file) != 1 ||
+      fread(&width, sizeof(int), 1, file) != 1)
+    altReadError(params->altFile, "not a landmark file");
+  fclose(file);
+  if (version != ALT_VERSION)
+    altReadError(params->altFile, "unsupported version");
+  if (width != 4 && width != 8)
+    altReadError(params->altFile, "bad table width");
+  return width == 8;
+}
+
+//-------------------------------------------------------------
+// ALTWorker
+//     One thread's private search state: an SP with the chosen
+//     one-to-all engine on the graph and another on its reverse,
+//     each with its own Node array.
+//-------------------------------------------------------------
+
+typedef struct ALTWorker {
+  Node *nodes[2];
+  SP *sp[2];
+} ALTWorker;
+
+static void altWorkerInit(ALTWorker *worker, CSRGraph *graph, int queueType)
+{
+  SPParams params;
+  CSRGraph *g;
+  long long dDist, maxArcLen;
+  int dir;
+
+  spDefaultParams(&params);
+  ArcLen(graph, NULL, &maxArcLen);
+  dDist = maxArcLen * (graph->n - 1);
+  params.wideKeys = ((double) dDist > 2147483647.0);
+
+  for (dir = 0; dir < 2; dir++) {
+    g = dir ? graph->reverse : graph;
+    worker->nodes[dir] = (Node *) calloc(g->n + 1, sizeof(Node));
+    if (worker->nodes[dir] == NULL) {
+      fprintf(stderr, "ERROR: can't allocate landmark search labels\n");
+      exit(1);
+    }
+    worker->sp[dir] = new SP(g, worker->nodes[dir], queueType, SP_MODE_SS,
+			     &params);
+    worker->sp[dir]->init();
+  }
+}
+
+static void altWorkerFree(ALTWorker *worker)
+{
+  int dir;
+
+  for (dir = 0; dir < 2; dir++) {
+    delete worker->sp[dir];
+    free(worker->nodes[dir]);
+  }
+}
+
+// one-to-all search from root; dir 1 gives distances to root
+static Node *altSearch(ALTWorker *worker, int dir, long root)
+{
+  SP *sp = worker->sp[dir];
+  Node *source = worker->nodes[dir] + root;
+
+  sp->initS(source);
+  sp->sp(source);
+  return worker->nodes[dir];
+}
+
+static inline bool altReached(ALTWorker *worker, int dir, Node *v)
+{
+  return v->tStamp == worker->sp[dir]->curTime;
+}
+
+//-------------------------------------------------------------
+// Parallel table computation
+//     A job is one direction of one landmark; threads take jobs
+//     from a shared counter until none are left.
+//-------------------------------------------------------------
+
+template <class T>
+struct ALTJobs {
+  pthread_mutex_t lock;
+  long next, last;           // jobs next .. last-1 are left
+  long *landmark;
+  T *fwd, *rev;
+  long n;
+  int k;
+  ALTWorker *worker;         // one per thread
+};
+
+template <class T>
+struct ALTThread {
+  ALTJobs<T> *jobs;
+  int id;
+};
+
+template <class T>
+static void *altRunJobs(void *arg)
+{
+  ALTThread<T> *thread = (ALTThread<T> *) arg;
+  ALTJobs<T> *jobs = thread->jobs;
+  ALTWorker *worker = jobs->worker + thread->id;
+  long job, v;
+  int i, dir;
+  Node *nodes;
+  T *table;
+
+  for (;;) {
+    pthread_mutex_lock(&jobs->lock);
+    job = jobs->next++;
+    pthread_mutex_unlock(&jobs->lock);
+    if (job >= jobs->last)
+      break;
+
+    i = job / 2;
+    dir = job % 2;
+    table = dir ? jobs->rev : jobs->fwd;
+    nodes = altSearch(worker, dir, jobs->landmark[i]);
+    for (v = 0; v < jobs->n; v++)
+      table[v * jobs->k + i] = altReached(worker, dir, nodes + v) ?
+	(T) nodes[v].dist : (T) ~(T) 0;
+  }
+  return NULL;
+}
+
+// fills the table columns of landmarks first .. last-1
+template <class T>
+static void altTables(ALTJobs<T> *jobs, int threads, int first, int last)
+{
+  ALTThread<T> *thread;
+  pthread_t *tid;
+  int t, cThreads;
+
+  jobs->next = 2 * (long) first;
+  jobs->last = 2 * (long) last;
+  cThreads = threads;
+  if (cThreads > jobs->last - jobs->next)
+    cThreads = jobs->last - jobs->next;
+
+  thread = new ALTThread<T>[cThreads];
+  tid = new pthread_t[cThreads];
+  for (t = 0; t < cThreads; t++) {
+    thread[t].jobs = jobs;
+    thread[t].id = t;
+  }
+  // the calling thread is worker 0
+  for (t = 1; t < cThreads; t++)
+    if (pthread_create(tid + t, NULL, altRunJobs<T>, thread + t) != 0) {
+      fprintf(stderr, "ERROR: can't start a preprocessing thread\n");
+      exit(1);
+    }
+  altRunJobs<T>(thread);
+  for (t = 1; t < cThreads; t++)
+    pthread_join(tid[t], NULL);
+
+  delete [] thread;
+  delete [] tid;
+}
+
+template <class T>
+LandmarkPotential<T>::LandmarkPotential(CSRGraph *graphGiven)
+{
+  long long maxArcLen;
+
+  graph = graphGiven;
+  n = graph->n;
+  k = 0;
+  landmark = NULL;
+  fwd = rev = NULL;
+  fwdT = revT = NULL;
+  owner = true;
+  ArcLen(graph, NULL, &maxArcLen);
+  maxBound = maxArcLen * (n - 1);
+}
+
+template <class T>
+LandmarkPotential<T>::~LandmarkPotential()
+{
+  if (!owner)
+    return;
+  delete [] landmark;
+  delete [] fwd;
+  delete [] rev;
+}
+
+template <class T>
+LandmarkPotential<T> *LandmarkPotential<T>::Clone()
+{
+  LandmarkPotential<T> *clone = new LandmarkPotential<T>(*this);
+
+  clone->owner = false;
+  return clone;
+}
+
+template <class T>
+void LandmarkPotential<T>::Alloc(int kGiven)
+{
+  k = kGiven;
+  landmark = new long[k];
+  fwd = new T[n * k];
+  rev = new T[n * k];
+}
+
+//-------------------------------------------------------------
+// LandmarkPotential::Build()
+// LandmarkPotential::Select()
+//     Select() picks the landmarks and fills the tables.  Planar
+//     selection needs one search from the center, so all tables are
+//     computed together at the end.  Avoid and farthest look at the
+//     tables of the landmarks picked so far, so each landmark's
+//     forward and reverse tables are computed (in parallel) before
+//     the next one is picked.
+//-------------------------------------------------------------
+
+template <class T>
+void LandmarkPotential<T>::Build(int method, int count, int queueType,
+				 int threads)
+{
+  if (count < 1 || count > n) {
+    fprintf(stderr, "ERROR: can't select %d landmarks out of %ld nodes\n",
+	    count, n);
+    exit(1);
+  }
+  if (method == ALT_PLANAR && graph->x == NULL) {
+    fprintf(stderr, "ERROR: planar landmarks need node coordinates (--co=<file>)\n");
+    exit(1);
+  }
+  if (threads < 1)
+    threads = 1;
+  csr_add_reverse(graph);
+  Alloc(count);
+  Select(method, queueType, threads);
+}
+
+template <class T>
+void LandmarkPotential<T>::Select(int method, int queueType, int threads)
+{
+  const T inf = (T) ~(T) 0;
+  ALTJobs<T> jobs;
+  ALTWorker *worker;
+  Node *nodes;
+  long v, w, root, best, *count, *child, *stack, cStack, *parent;
+  long long bestScore, score, d, lb;
+  double *size, xc, yc, bestSize;
+  bool *covered;
+  unsigned long seed = 12345;
+  int i, j, t, sector;
+
+  worker = new ALTWorker[threads];
+  for (t = 0; t < threads; t++)
+    altWorkerInit(worker + t, graph, queueType);
+  pthread_mutex_init(&jobs.lock, NULL);
+  jobs.landmark = landmark;
+  jobs.fwd = fwd;
+  jobs.rev = rev;
+  jobs.n = n;
+  jobs.k = k;
+  jobs.worker = worker;
+
+  if (method == ALT_PLANAR) {
+    // center: the node closest to the mean of the coordinates
+    xc = yc = 0.0;
+    for (v = 0; v < n; v++) {
+      xc += graph->x[v];
+      yc += graph->y[v];
+    }
+    xc /= n;
+    yc /= n;
+    root = 0;
+    for (v = 1; v < n; v++)
+      if (hypot(graph->x[v] - xc, graph->y[v] - yc) <
+	  hypot(graph->x[root] - xc, graph->y[root] - yc))
+	root = v;
+
+    // the farthest reachable node in each of k sectors around it
+    nodes = altSearch(worker, 0, root);
+    for (i = 0; i < k; i++)
+      landmark[i] = -1;
+    for (v = 0; v < n; v++) {
+      if (!altReached(worker, 0, nodes + v) || v == root)
+	continue;
+      sector = (int) ((atan2((double) (graph->y[v] - graph->y[root]),
+			     (double) (graph->x[v] - graph->x[root]))
+		       + ALT_PI) / (2.0 * ALT_PI) * k);
+      if (sector >= k) sector = k - 1;
+      if (landmark[sector] < 0 || nodes[v].dist > nodes[landmark[sector]].dist)
+	landmark[sector] = v;
+    }
+    // empty sectors get the farthest nodes not yet taken
+    for (i = 0; i < k; i++)
+      if (landmark[i] < 0) {
+	best = root;
+	for (v = 0; v < n; v++) {
+	  if (!altReached(worker, 0, nodes + v))
+	    continue;
+	  for (j = 0; j < k && landmark[j] != v; j++) ;
+	  if (j == k && nodes[v].dist > nodes[best].dist)
+	    best = v;
+	}
+	landmark[i] = best;
+      }
+    altTables(&jobs, threads, 0, k);
+  }
+  else if (method == ALT_FARTHEST) {
+    // start from the node farthest from a random root
+    seed = seed * 1103515245 + 12345;
+    root = (long) (seed % n);
+    nodes = altSearch(worker, 0, root);
+    best = root;
+    for (v = 0; v < n; v++)
+      if (altReached(worker, 0, nodes + v) && nodes[v].dist > nodes[best].dist)
+	best = v;
+    for (i = 0; i < k; i++) {
+      if (i > 0) {
+	// maximize the distance to the nearest landmark; nodes no
+	// landmark reaches are the farthest of all
+	best = -1;
+	bestScore = -1;
+	for (v = 0; v < n; v++) {
+	  score = -1;
+	  for (j = 0; j < i; j++)
+	    if (fwd[v * k + j] != inf &&
+		(score < 0 || (long long) fwd[v * k + j] < score))
+	      score = fwd[v * k + j];
+	  if (score < 0)
+	    score = maxBound + 1;
+	  if (score > bestScore) {
+	    bestScore = score;
+	    best = v;
+	  }
+	}
+      }
+      landmark[i] = best;
+      altTables(&jobs, threads, i, i + 1);
+    }
+  }
+  else {                        // ALT_AVOID
+    count = new long[n + 1];
+    child = new long[n];
+    stack = new long[n];
+    size = new double[n];
+    covered = new bool[n];
+    for (i = 0; i < k; i++) {
+      seed = seed * 1103515245 + 12345;
+      root = (long) ((seed >> 8) % n);
+      nodes = altSearch(worker, 0, root);
+      parent = worker->sp[0]->getParents();
+
+      // children of each node in the shortest path tree, as CSR
+      for (v = 0; v <= n; v++)
+	count[v] = 0;
+      for (v = 0; v < n; v++)
+	if (v != root && altReached(worker, 0, nodes + v))
+	  count[parent[v] + 1]++;
+      for (v = 0; v < n; v++)
+	count[v + 1] += count[v];
+      for (v = 0; v < n; v++)
+	if (v != root && altReached(worker, 0, nodes + v))
+	  child[count[parent[v]]++] = v;
+      for (v = n; v > 0; v--)
+	count[v] = count[v - 1];
+      count[0] = 0;
+
+      // preorder, then sizes bottom up: a node weighs how much the
+      // landmarks so far underestimate its distance from the root
+      cStack = 0;
+      stack[cStack++] = root;
+      for (t = 0; t < cStack; t++)
+	for (w = count[stack[t]]; w < count[stack[t] + 1]; w++)
+	  stack[cStack++] = child[w];
+      for (t = cStack - 1; t >= 0; t--) {
+	v = stack[t];
+	lb = 0;
+	for (j = 0; j < i; j++) {
+	  if (fwd[root * k + j] != inf && fwd[v * k + j] != inf) {
+	    d = (long long) fwd[v * k + j] - (long long) fwd[root * k + j];
+	    if (d > lb) lb = d;
+	  }
+	  if (rev[root * k + j] != inf && rev[v * k + j] != inf) {
+	    d = (long long) rev[root * k + j] - (long long) rev[v * k + j];
+	    if (d > lb) lb = d;
+	  }
+	}
+	size[v] = (double) (nodes[v].dist - lb);
+	covered[v] = false;
+	for (j = 0; j < i; j++)
+	  if (landmark[j] == v)
+	    covered[v] = true;
+	for (w = count[v]; w < count[v + 1]; w++) {
+	  covered[v] = covered[v] || covered[child[w]];
+	  size[v] += size[child[w]];
+	}
+	if (covered[v])
+	  size[v] = 0.0;
+      }
+
+      // descend into the biggest subtree down to a leaf
+      v = root;
+      for (;;) {
+	best = -1;
+	bestSize = 0.0;
+	for (w = count[v]; w < count[v + 1]; w++)
+	  if (size[child[w]] > bestSize) {
+	    bestSize = size[child[w]];
+	    best = child[w];
+	  }
+	if (best < 0)
+	  break;
+	v = best;
+      }
+      landmark[i] = v;
+      altTables(&jobs, threads, i, i + 1);
+    }
+    delete [] count;
+    delete [] child;
+    delete [] stack;
+    delete [] size;
+    delete [] covered;
+  }
+
+  pthread_mutex_destroy(&jobs.lock);
+  for (t = 0; t < threads; t++)
+    altWorkerFree(worker + t);
+  delete [] worker;
+}
+
+template <class T>
+void LandmarkPotential<T>::Write(const char *fileName)
+{
+  FILE *file = altOpen(fileName, "wb");
+  int version = ALT_VERSION, width = sizeof(T);
+  unsigned long long hash = csr_hash(graph);
+  long long nk[2], id;
+  int i;
+
+  nk[0] = n;
+  nk[1] = k;
+  fwrite("ALT", 1, 4, file);
+  fwrite(&version, sizeof(int), 1, file);
+  fwrite(&width, sizeof(int), 1, file);
+  fwrite(&graph->order, sizeof(int), 1, file);
+  fwrite(&hash, sizeof(unsigned long long), 1, file);
+  fwrite(nk, sizeof(long long), 2, file);
+  for (i = 0; i < k; i++) {
+    id = landmark[i];
+    fwrite(&id, sizeof(long long), 1, file);
+  }
+  fwrite(fwd, sizeof(T), n * k, file);
+  if (fwrite(rev, sizeof(T), n * k, file) != (size_t) (n * k) ||
+      fclose(file) != 0) {
+    fprintf(stderr, "ERROR: can't write landmark file %s\n", fileName);
+    exit(1);
+  }
+}
+
+template <class T>
+void LandmarkPotential<T>::Read(const char *fileName)
+{
+  FILE *file = altOpen(fileName, "rb");
+  char magic[4];
+  int version, width, order;
+  unsigned long long hash;
+  long long nk[2], id;
+  int i;
+
+  if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "ALT", 4) != 0 ||
+      fread(&version, sizeof(int), 1, file) != 1 ||
+      fread(&width, sizeof(int), 1, file) != 1 ||
+      fread(&order, sizeof(int), 1, file) != 1 ||
+      fread(&hash, sizeof(unsigned long long), 1, file) != 1 ||
+      fread(nk, sizeof(long long), 2, file) != 2)
+    altReadError(fileName, "not a landmark file");
+  if (version != ALT_VERSION)
+    altReadError(fileName, "unsupported version");
+  if (width != (int) sizeof(T))
+    altReadError(fileName, "bad table width");
+  if (nk[0] != n)
+    altReadError(fileName, "number of nodes differs from the graph");
+  csr_check_stamp(graph, order, hash, "landmark file", fileName);
+  if (nk[1] < 1 || nk[1] > n)
+    altReadError(fileName, "bad number of landmarks");
+
+  Alloc((int) nk[1]);
+  for (i = 0; i < k; i++) {
+    if (fread(&id, sizeof(long long), 1, file) != 1 || id < 0 || id >= n)
+      altReadError(fileName, "bad landmark");
+    landmark[i] = (long) id;
+  }
+  if (fread(fwd, sizeof(T), n * k, file) != (size_t) (n * k) ||
+      fread(rev, sizeof(T), n * k, file) != (size_t) (n * k))
+    altReadError(fileName, "file is truncated");
+  fclose(file);
+}
+
+// the two table widths altWideTables() chooses from
+template class LandmarkPotential<unsigned int>;
+template class LandmarkPotential<unsigned long long>;
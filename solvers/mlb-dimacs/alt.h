@@ -0,0 +1,137 @@
+// alt.h
+//     ALT: A* with landmarks and the triangle inequality.  For each
+//     landmark L we keep d(L, v) (forward table) and d(v, L) (reverse
+//     table) for every node v.  Then
+//
+//        d(v, t) >= d(L, t) - d(L, v)   and   d(v, t) >= d(v, L) - d(t, L)
+//
+//     and the maximum over all landmarks is a feasible lower bound,
+//     used as the potential of AStarEngine (astar.h).  No coordinates
+//     are needed.
+//
+//     Landmarks are selected by one of
+//
+//       avoid     grow a shortest path tree from a random root and
+//                 descend into the subtree worst covered by the
+//                 landmarks so far (Goldberg and Werneck)
+//       farthest  repeatedly take the node farthest from the landmarks
+//       planar    split the plane around a central node into sectors
+//                 and take the farthest node in each (needs a .co file)
+//
+//     and the tables are computed with the one-to-all engines of the
+//     chosen queue backend, on the graph and on its reverse, by
+//     several threads.  Tables can be saved to and read from a binary
+//     file:
+//
+//       char     magic[4]          "ALT\0"
+//       int      version           ALT_VERSION
+//       int      width             sizeof(T): 4 or 8
+//       int      order             graph->order, and
+//       unsigned long long hash    csr_hash() of the graph
+//       long long n, k
+//       long long landmark[k]      node indices
+//       T        fwd[n * k]        fwd[v * k + i] = d(landmark i, v)
+//       T        rev[n * k]        rev[v * k + i] = d(v, landmark i)
+//
+//     in host byte order.  Unreachable is ~0.  T is unsigned int when
+//     every distance fits, unsigned long long otherwise; rows are per
+//     node so one bound reads two contiguous rows.
+
+#ifndef ALT_H
+#define ALT_H
+
+#include "sp.h"
+
+#define ALT_AVOID           1          // landmark selection methods
+#define ALT_FARTHEST        2
+#define ALT_PLANAR          3
+
+#define ALT_VERSION         2
+
+int altFindMethod(const char *name);   // 0 if unknown
+// whether the tables for params need 64-bit entries
+bool altWideTables(CSRGraph *graph, SPParams *params);
+
+template <class T>
+class LandmarkPotential {
+ private:
+   CSRGraph *graph;
+   long n;
+   int k;
+   long *landmark;
+   T *fwd, *rev;
+   long long maxBound;        // no distance is longer
+   const T *fwdT, *revT;      // rows of the current target
+   bool owner;                // frees the tables; false for clones
+
+   void Alloc(int kGiven);
+   void Select(int method, int queueType, int threads);
+ public:
+   LandmarkPotential(CSRGraph *graphGiven);
+   ~LandmarkPotential();
+   LandmarkPotential *Clone();
+   void Build(int method, int count, int queueType, int threads);
+   void Read(const char *fileName);
+   void Write(const char *fileName);
+
+   void Init(long t)          { fwdT = fwd + t * k;  revT = rev + t * k; }
+   long long Bound(long v);
+};
+
+//-------------------------------------------------------------
+// LandmarkPotential::Bound()
+//     Max over landmarks of both triangle inequalities.  An
+//     infinite table entry is taken at face value: if t is
+//     reachable from L but v is not, that landmark says nothing;
+//     if v is reachable from L but t is not, t cannot be reached
+//     from v either, and the bound is maxBound.
+//-------------------------------------------------------------
+
+template <class T>
+inline long long LandmarkPotential<T>::Bound(long v)
+{
+  const T inf = (T) ~(T) 0;
+  const T *fv = fwd + v * k, *rv = rev + v * k;
+  long long b = 0, d;
+  int i;
+
+  for (i = 0; i < k; i++) {
+    if (fwdT[i] != inf) {
+      if (fv[i] != inf) {
+	d = (long long) fwdT[i] - (long long) fv[i];
+	if (d > b) b = d;
+      }
+    }
+    else if (fv[i] != inf)
+      return maxBound;
+    if (revT[i] != inf) {
+      if (rv[i] != inf) {
+	d = (long long) rv[i] - (long long) revT[i];
+	if (d > b) b = d;
+      }
+      else
+	return maxBound;
+    }
+  }
+  return b;
+}
+
+// builds (and writes, if params->altFile is set) or reads the tables
+template <class T>
+LandmarkPotential<T> *altLoad(CSRGraph *graph, int queueType,
+			      SPParams *params)
+{
+  LandmarkPotential<T> *potential = new LandmarkPotential<T>(graph);
+
+  if (params->altMethod) {
+    potential->Build(params->altMethod, params->altCount, queueType,
+		     params->threads);
+    if (params->altFile)
+      potential->Write(params->altFile);
+  }
+  else
+    potential->Read(params->altFile);
+  return potential;
+}
+
+#endif
@@ -0,0 +1,533 @@
+// arcflags.cc
+//     Partitioning, flag computation and the flag file for arc-flags
+//     (see arcflags.h).
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <algorithm>
+#include <vector>
+#include "arcflags.h"
+
+int afFindMethod(const char *name)
+{
+  if (strcmp(name, "coords") == 0) return AF_COORDS;
+  if (strcmp(name, "grow") == 0)   return AF_GROW;
+  return 0;
+}
+
+static FILE *afOpen(const char *fileName, const char *how)
+{
+  FILE *file = fopen(fileName, how);
+
+  if (file == NULL) {
+    fprintf(stderr, "ERROR: can't open arc-flag file %s\n", fileName);
+    exit(1);
+  }
+  return file;
+}
+
+static void afReadError(const char *fileName, const char *message)
+{
+  fprintf(stderr, "ERROR: arc-flag file %s: %s\n", fileName, message);
+  exit(1);
+}
+
+ArcFlags::ArcFlags(CSRGraph *graphGiven)
+{
+  graph = graphGiven;
+  n = graph->n;
+  m = graph->m;
+  k = 0;
+  words = (m + 63) / 64;
+  cell = NULL;
+  flags = NULL;
+}
+
+ArcFlags::~ArcFlags()
+{
+  delete [] cell;
+  delete [] flags;
+}
+
+void ArcFlags::Alloc(int kGiven)
+{
+  k = kGiven;
+  cell = new long[n];
+  flags = new AFWord[k * words];
+  memset(flags, 0, k * words * sizeof(AFWord));
+}
+
+//-------------------------------------------------------------
+// ArcFlags::PartitionCoords()
+//     Splits the nodes at the median of the coordinate with the
+//     wider extent, giving each side a share of the cells, until
+//     each part is one cell.
+//-------------------------------------------------------------
+
+struct AFCoordLess {
+  const long *c;
+  bool operator()(long a, long b) const
+  { return c[a] < c[b] || (c[a] == c[b] && a < b); }
+};
+
+static void afBisect(CSRGraph *graph, long *ids, long count, int firstCell,
+		     int cells, long *cell)
+{
+  AFCoordLess less;
+  long i, split, xMin, xMax, yMin, yMax;
+  int left;
+
+  if (cells == 1 || count == 0) {
+    for (i = 0; i < count; i++)
+      cell[ids[i]] = firstCell;
+    return;
+  }
+  xMin = xMax = graph->x[ids[0]];
+  yMin = yMax = graph->y[ids[0]];
+  for (i = 1; i < count; i++) {
+    if (graph->x[ids[i]] < xMin) xMin = graph->x[ids[i]];
+    if (graph->x[ids[i]] > xMax) xMax = graph->x[ids[i]];
+    if (graph->y[ids[i]] < yMin) yMin = graph->y[ids[i]];
+    if (graph->y[ids[i]] > yMax) yMax = graph->y[ids[i]];
+  }
+  less.c = (double) xMax - xMin >= (double) yMax - yMin ? graph->x : graph->y;
+
+  left = cells / 2;
+  split = (long) ((double) count * left / cells);
+  std::nth_element(ids, ids + split, ids + count, less);
+  afBisect(graph, ids, split, firstCell, left, cell);
+  afBisect(graph, ids + split, count - split, firstCell + left, cells - left,
+	   cell);
+}
+
+void ArcFlags::PartitionCoords()
+{
+  long *ids = new long[n], v;
+
+  for (v = 0; v < n; v++)
+    ids[v] = v;
+  afBisect(graph, ids, n, 0, k, cell);
+  delete [] ids;
+}
+
+//-------------------------------------------------------------
+// ArcFlags::PartitionGrow()
+//     Seeds are picked farthest-first by hops, ignoring arc
+//     directions: each new seed is the node farthest from those so
+//     far (any node they cannot reach comes first).  Then the cells
+//     grow breadth-first from their seeds, taking turns one scanned
+//     node at a time so they stay about the same size.  Nodes no
+//     seed reaches go, a component at a time, to the smallest cell.
+//-------------------------------------------------------------
+
+// appends the neighbors w of v, in either direction, to list: with
+// hop given, those it brings closer (hop[w] > hop[v] + 1), else those
+// without a cell, which join cell c
+static void afNeighbors(CSRGraph *graph, long v, long *hop, long *cell,
+			int c, std::vector<long> *list)
+{
+  CSRGraph *g;
+  long a, w;
+  int dir;
+
+  for (dir = 0; dir < 2; dir++) {
+    g = dir ? graph->reverse : graph;
+    for (a = g->first[v]; a < g->first[v + 1]; a++) {
+      w = csr_head(g, a);
+      if (hop ? hop[v] + 1 < hop[w] : cell[w] < 0) {
+	if (hop)
+	  hop[w] = hop[v] + 1;
+	else
+	  cell[w] = c;
+	list->push_back(w);
+      }
+    }
+  }
+}
+
+void ArcFlags::PartitionGrow()
+{
+  std::vector<long> *queue = new std::vector<long>[k], bfs;
+  long *head = new long[k], *size = new long[k], *hop = new long[n];
+  long v, i, best, before;
+  bool active;
+  int c, smallest;
+
+  for (v = 0; v < n; v++) {
+    hop[v] = LONG_MAX;
+    cell[v] = -1;
+  }
+
+  // seeds; hop[] is the distance to the nearest one so far
+  best = 0;
+  for (c = 0; c < k; c++) {
+    for (v = 0; v < n; v++)
+      if (hop[v] > hop[best])
+	best = v;
+    cell[best] = c;
+    queue[c].push_back(best);
+    hop[best] = 0;
+    bfs.clear();
+    bfs.push_back(best);
+    for (i = 0; i < (long) bfs.size(); i++)
+      afNeighbors(graph, bfs[i], hop, NULL, 0, &bfs);
+  }
+
+  // growth
+  for (c = 0; c < k; c++) {
+    head[c] = 0;
+    size[c] = 1;
+  }
+  do {
+    active = false;
+    for (c = 0; c < k; c++) {
+      if (head[c] == (long) queue[c].size())
+	continue;
+      active = true;
+      before = (long) queue[c].size();
+      afNeighbors(graph, queue[c][head[c]++], NULL, cell, c, queue + c);
+      size[c] += (long) queue[c].size() - before;
+    }
+  } while (active);
+
+  // leftovers
+  for (v = 0; v < n; v++) {
+    if (cell[v] >= 0)
+      continue;
+    smallest = 0;
+    for (c = 1; c < k; c++)
+      if (size[c] < size[smallest])
+	smallest = c;
+    bfs.clear();
+    bfs.push_back(v);
+    cell[v] = smallest;
+    for (i = 0; i < (long) bfs.size(); i++)
+      afNeighbors(graph, bfs[i], NULL, cell, smallest, &bfs);
+    size[smallest] += (long) bfs.size();
+  }
+
+  delete [] queue;
+  delete [] head;
+  delete [] size;
+  delete [] hop;
+}
+
+//-------------------------------------------------------------
+// AFWorker
+//     One thread's private search state: an SP with the chosen
+//     one-to-all engine on the reverse graph.
+//-------------------------------------------------------------
+
+typedef struct AFWorker {
+  Node *nodes;
+  SP *sp;
+} AFWorker;
+
+static void afWorkerInit(AFWorker *worker, CSRGraph *graph, int queueType)
+{
+  SPParams params;
+  long long maxArcLen;
+
+  spDefaultParams(&params);
+  ArcLen(graph, NULL, &maxArcLen);
+  params.wideKeys = ((double) maxArcLen * (graph->n - 1) > 2147483647.0);
+
+  worker->nodes = (Node *) calloc(graph->n + 1, sizeof(Node));
+  if (worker->nodes == NULL) {
+    fprintf(stderr, "ERROR: can't allocate boundary search labels\n");
+    exit(1);
+  }
+  worker->sp = new SP(graph->reverse, worker->nodes, queueType, SP_MODE_SS,
+		      &params);
+  worker->sp->init();
+}
+
+static void afWorkerFree(AFWorker *worker)
+{
+  delete worker->sp;
+  free(worker->nodes);
+}
+
+//-------------------------------------------------------------
+// Parallel flag computation
+//     A job is one cell: its inner arcs and the searches from all
+//     its boundary nodes.  Only that job writes the cell's row, so
+//     threads need no locking beyond the shared job counter.  Cells
+//     with many boundary nodes go first.
+//-------------------------------------------------------------
+
+typedef struct AFJobs {
+  pthread_mutex_t lock;
+  long next;
+  int k;
+  int *order;                // cells, most boundary nodes first
+  long *member, *memberFirst;     // nodes of each cell, as CSR
+  long *boundary, *boundaryFirst; // boundary nodes of each cell
+  long *cell;
+  long words;
+  AFWord *flags;
+  CSRGraph *graph;
+  AFWorker *worker;          // one per thread
+} AFJobs;
+
+typedef struct AFThread {
+  AFJobs *jobs;
+  int id;
+} AFThread;
+
+static void *afRunJobs(void *arg)
+{
+  AFThread *thread = (AFThread *) arg;
+  AFJobs *jobs = thread->jobs;
+  AFWorker *worker = jobs->worker + thread->id;
+  CSRGraph *graph = jobs->graph;
+  AFWord *row;
+  Node *nodes = worker->nodes, *source, *w;
+  long job, i, u, a;
+  int c;
+
+  for (;;) {
+    pthread_mutex_lock(&jobs->lock);
+    job = jobs->next++;
+    pthread_mutex_unlock(&jobs->lock);
+    if (job >= jobs->k)
+      break;
+
+    c = jobs->order[job];
+    row = jobs->flags + c * jobs->words;
+
+    // arcs inside the cell
+    for (i = jobs->memberFirst[c]; i < jobs->memberFirst[c + 1]; i++) {
+      u = jobs->member[i];
+      for (a = graph->first[u]; a < graph->first[u + 1]; a++)
+	if (jobs->cell[csr_head(graph, a)] == c)
+	  row[a >> 6] |= (AFWord) 1 << (a & 63);
+    }
+
+    // arcs on shortest paths to a boundary node: dist(u) equals
+    // len(u,v) + dist(v) in the search on the reverse graph
+    for (i = jobs->boundaryFirst[c]; i < jobs->boundaryFirst[c + 1]; i++) {
+      source = nodes + jobs->boundary[i];
+      worker->sp->initS(source);
+      worker->sp->sp(source);
+      for (u = 0; u < graph->n; u++) {
+	if (nodes[u].tStamp != worker->sp->curTime)
+	  continue;
+	for (a = graph->first[u]; a < graph->first[u + 1]; a++) {
+	  w = nodes + csr_head(graph, a);
+	  if (w->tStamp == worker->sp->curTime &&
+	      nodes[u].dist == csr_len(graph, a) + w->dist)
+	    row[a >> 6] |= (AFWord) 1 << (a & 63);
+	}
+      }
+    }
+  }
+  return NULL;
+}
+
+struct AFMoreBoundary {
+  const long *first;
+  bool operator()(int c, int d) const
+  { return first[c + 1] - first[c] > first[d + 1] - first[d]; }
+};
+
+void ArcFlags::SetFlags(int queueType, int threads)
+{
+  AFJobs jobs;
+  AFThread *thread;
+  AFMoreBoundary more;
+  pthread_t *tid;
+  CSRGraph *rev = graph->reverse;
+  long v, a, *count;
+  int c, t, cThreads;
+  bool isBoundary;
+
+  // members and boundary nodes of each cell, as CSR
+  jobs.member = new long[n];
+  jobs.memberFirst = new long[k + 1];
+  jobs.boundaryFirst = new long[k + 1];
+  count = new long[k + 1];
+  for (c = 0; c <= k; c++)
+    jobs.memberFirst[c] = jobs.boundaryFirst[c] = 0;
+  for (v = 0; v < n; v++) {
+    jobs.memberFirst[cell[v] + 1]++;
+    for (a = rev->first[v]; a < rev->first[v + 1]; a++)
+      if (cell[csr_head(rev, a)] != cell[v]) {
+	jobs.boundaryFirst[cell[v] + 1]++;
+	break;
+      }
+  }
+  for (c = 0; c < k; c++) {
+    jobs.memberFirst[c + 1] += jobs.memberFirst[c];
+    jobs.boundaryFirst[c + 1] += jobs.boundaryFirst[c];
+  }
+  jobs.boundary = new long[jobs.boundaryFirst[k] + 1];
+  for (c = 0; c < k; c++)
+    count[c] = jobs.memberFirst[c];
+  for (v = 0; v < n; v++)
+    jobs.member[count[cell[v]]++] = v;
+  for (c = 0; c < k; c++)
+    count[c] = jobs.boundaryFirst[c];
+  for (v = 0; v < n; v++) {
+    isBoundary = false;
+    for (a = rev->first[v]; a < rev->first[v + 1] && !isBoundary; a++)
+      isBoundary = cell[csr_head(rev, a)] != cell[v];
+    if (isBoundary)
+      jobs.boundary[count[cell[v]]++] = v;
+  }
+  delete [] count;
+
+  jobs.order = new int[k];
+  for (c = 0; c < k; c++)
+    jobs.order[c] = c;
+  more.first = jobs.boundaryFirst;
+  std::stable_sort(jobs.order, jobs.order + k, more);
+
+  jobs.next = 0;
+  jobs.k = k;
+  jobs.cell = cell;
+  jobs.words = words;
+  jobs.flags = flags;
+  jobs.graph = graph;
+
+  cThreads = threads < k ? threads : k;
+  jobs.worker = new AFWorker[cThreads];
+  for (t = 0; t < cThreads; t++)
+    afWorkerInit(jobs.worker + t, graph, queueType);
+  pthread_mutex_init(&jobs.lock, NULL);
+
+  thread = new AFThread[cThreads];
+  tid = new pthread_t[cThreads];
+  for (t = 0; t < cThreads; t++) {
+    thread[t].jobs = &jobs;
+    thread[t].id = t;
+  }
+  // the calling thread is worker 0
+  for (t = 1; t < cThreads; t++)
+    if (pthread_create(tid + t, NULL, afRunJobs, thread + t) != 0) {
+      fprintf(stderr, "ERROR: can't start a preprocessing thread\n");
+      exit(1);
+    }
+  afRunJobs(thread);
+  for (t = 1; t < cThreads; t++)
+    pthread_join(tid[t], NULL);
+
+  pthread_mutex_destroy(&jobs.lock);
+  for (t = 0; t < cThreads; t++)
+    afWorkerFree(jobs.worker + t);
+  delete [] jobs.worker;
+  delete [] thread;
+  delete [] tid;
+  delete [] jobs.order;
+  delete [] jobs.member;
+  delete [] jobs.memberFirst;
+  delete [] jobs.boundary;
+  delete [] jobs.boundaryFirst;
+}
+
+void ArcFlags::Build(int method, int count, int queueType, int threads)
+{
+  if (count < 1 || count > n) {
+    fprintf(stderr, "ERROR: can't partition %ld nodes into %d cells\n",
+	    n, count);
+    exit(1);
+  }
+  if (method == AF_COORDS && graph->x == NULL) {
+    fprintf(stderr, "ERROR: coordinate partitioning needs node coordinates (--co=<file>)\n");
+    exit(1);
+  }
+  if (threads < 1)
+    threads = 1;
+  csr_add_reverse(graph);
+  Alloc(count);
+  if (method == AF_COORDS)
+    PartitionCoords();
+  else
+    PartitionGrow();
+  SetFlags(queueType, threads);
+}
+
+void ArcFlags::Write(const char *fileName)
+{
+  FILE *file = afOpen(fileName, "wb");
+  int version = AF_VERSION;
+  unsigned long long hash = csr_hash(graph);
+  long long nmk[3], id;
+  long v;
+
+  nmk[0] = n;
+  nmk[1] = m;
+  nmk[2] = k;
+  fwrite("AF\0", 1, 4, file);
+  fwrite(&version, sizeof(int), 1, file);
+  fwrite(&graph->order, sizeof(int), 1, file);
+  fwrite(&hash, sizeof(unsigned long long), 1, file);
+  fwrite(nmk, sizeof(long long), 3, file);
+  for (v = 0; v < n; v++) {
+    id = cell[v];
+    fwrite(&id, sizeof(long long), 1, file);
+  }
+  if (fwrite(flags, sizeof(AFWord), k * words, file) != (size_t) (k * words) ||
+      fclose(file) != 0) {
+    fprintf(stderr, "ERROR: can't write arc-flag file %s\n", fileName);
+    exit(1);
+  }
+}
+
+void ArcFlags::Read(const char *fileName)
+{
+  FILE *file = afOpen(fileName, "rb");
+  char magic[4];
+  int version, order;
+  unsigned long long hash;
+  long long nmk[3], id;
+  long v;
+
+  if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "AF\0", 4) != 0 ||
+      fread(&version, sizeof(int), 1, file) != 1 ||
+      fread(&order, sizeof(int), 1, file) != 1 ||
+      fread(&hash, sizeof(unsigned long long), 1, file) != 1 ||
+      fread(nmk, sizeof(long long), 3, file) != 3)
+    afReadError(fileName, "not an arc-flag file");
+  if (version != AF_VERSION)
+    afReadError(fileName, "unsupported version");
+  if (nmk[0] != n || nmk[1] != m)
+    afReadError(fileName, "graph size differs");
+  csr_check_stamp(graph, order, hash, "arc-flag file", fileName);
+  if (nmk[2] < 1 || nmk[2] > n)
+    afReadError(fileName, "bad number of cells");
+
+  Alloc((int) nmk[2]);
+  for (v = 0; v < n; v++) {
+    if (fread(&id, sizeof(long long), 1, file) != 1)
+      afReadError(fileName, "file is truncated");
+    if (id < 0 || id >= k)
+      afReadError(fileName, "bad cell");
+    cell[v] = (long) id;
+  }
+  if (fread(flags, sizeof(AFWord), k * words, file) != (size_t) (k * words))
+    afReadError(fileName, "file is truncated");
+  fclose(file);
+}
+
+ArcFlags *afLoad(CSRGraph *graph, int queueType, SPParams *params)
+{
+  ArcFlags *arcFlags = new ArcFlags(graph);
+
+  if (params->afMethod) {
+    arcFlags->Build(params->afMethod, params->afCells, queueType,
+		    params->threads);
+    if (params->afFile)
+      arcFlags->Write(params->afFile);
+  }
+  else if (params->afFile)
+    arcFlags->Read(params->afFile);
+  else {
+    fprintf(stderr, "ERROR: arcflags needs a flag file or a partition method\n");
+    exit(1);
+  }
+  return arcFlags;
+}
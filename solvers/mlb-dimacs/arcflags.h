@@ -0,0 +1,188 @@
+// arcflags.h
+//     Arc-flags: goal-directed point-to-point search on a partition
+//     of the graph into k cells.  Arc (u,v) is flagged for cell C if
+//     it lies on a shortest path into C; a search towards a sink in
+//     C then relaxes only the arcs flagged for C and still finds a
+//     shortest path.
+//
+//     Cells are built by one of
+//
+//       coords    recursive bisection at the median coordinate,
+//                 across the wider extent (needs a .co file)
+//       grow      breadth-first growth from k seeds spread out
+//                 farthest-first, the cells taking turns
+//
+//     An arc is flagged for C if both ends are in C, or if it is on
+//     a shortest path to a boundary node of C (a node of C with an
+//     arc coming in from another cell).  The latter is found by a
+//     one-to-all search from each boundary node on the reverse
+//     graph; cells are handed out to several threads.
+//
+//     Each cell's flags are a bit array parallel to the CSR arcs, so
+//     a query reads the m bits of one cell and the arcs themselves
+//     are untouched.  Flags can be saved to and read from a binary
+//     file:
+//
+//       char      magic[4]         "AF\0\0"
+//       int       version          AF_VERSION
+//       int       order            graph->order, and
+//       unsigned long long hash    csr_hash() of the graph
+//       long long n, m, k
+//       long long cell[n]
+//       AFWord    flags[k][(m + 63) / 64]
+//
+//     in host byte order; bit a % 64 of word a / 64 of row C is the
+//     flag of arc a for cell C.
+
+#ifndef ARCFLAGS_H
+#define ARCFLAGS_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "sp.h"
+
+#define AF_COORDS           1          // partition methods
+#define AF_GROW             2
+
+#define AF_VERSION          2
+
+typedef unsigned long long AFWord;
+
+int afFindMethod(const char *name);    // 0 if unknown
+
+class ArcFlags {
+ private:
+   CSRGraph *graph;
+   long n, m;
+   int k;
+   long *cell;                // cell of each node
+   long words;                // AFWords per row
+   AFWord *flags;             // k rows
+
+   void Alloc(int kGiven);
+   void PartitionCoords();
+   void PartitionGrow();
+   void SetFlags(int queueType, int threads);
+ public:
+   ArcFlags(CSRGraph *graphGiven);
+   ~ArcFlags();
+   void Build(int method, int count, int queueType, int threads);
+   void Read(const char *fileName);
+   void Write(const char *fileName);
+
+   // the flags of the cell of node v
+   const AFWord *Row(long v)  { return flags + cell[v] * words; }
+};
+
+static inline bool afFlagged(const AFWord *row, long a)
+{
+  return (row[a >> 6] >> (a & 63)) & 1;
+}
+
+template <class Queue>
+class ArcFlagEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   Queue *queue;
+   ArcFlags *arcFlags;
+   bool owner;                // deletes arcFlags; false for clones
+
+   template <class Arc>
+   bool search(Node *source, Node *sink, SP *sp, const Arc *arcs);
+ public:
+   ArcFlagEngine(CSRGraph *graphGiven, ArcFlags *arcFlagsGiven);
+   ~ArcFlagEngine();
+   SPEngine *Clone(Node *nodes);
+   bool run(Node *source, Node *sink, SP *sp);
+};
+
+template <class Queue>
+ArcFlagEngine<Queue>::ArcFlagEngine(CSRGraph *graphGiven,
+				    ArcFlags *arcFlagsGiven)
+{
+  graph = graphGiven;
+  arcFlags = arcFlagsGiven;
+  owner = true;
+  queue = new Queue(graph);
+}
+
+template <class Queue>
+ArcFlagEngine<Queue>::~ArcFlagEngine()
+{
+  delete queue;
+  if (owner)
+    delete arcFlags;
+}
+
+template <class Queue>
+SPEngine *ArcFlagEngine<Queue>::Clone(Node *)
+{
+  ArcFlagEngine<Queue> *clone = new ArcFlagEngine<Queue>(graph, arcFlags);
+
+  clone->owner = false;
+  return clone;
+}
+
+template <class Queue>
+bool ArcFlagEngine<Queue>::run(Node *source, Node *sink, SP *sp)
+{
+  if (graph->arcs32 != NULL)
+    return search(source, sink, sp, graph->arcs32);
+  return search(source, sink, sp, graph->arcs);
+}
+
+// the flags are indexed by arc position, the same in either layout
+template <class Queue>
+template <class Arc>
+bool ArcFlagEngine<Queue>::search(Node *source, Node *sink, SP *sp,
+				  const Arc *arcs)
+{
+  Node *nodes = sp->getNodes(), *u, *w;
+  long *parent = sp->getParents();
+  const Arc *arc, *lastArc;
+  const AFWord *row = arcFlags->Row(sink - nodes);
+  long v;
+  long long newDist;
+
+  sp->curTime++;
+  source->tStamp = sp->curTime;     // initS has set dist and parent
+
+  queue->Clear();
+  queue->Push(source - nodes, 0);
+  source->where = IN_HEAP;
+
+  while ((v = queue->PopMin()) >= 0) {
+    u = nodes + v;
+    u->where = IN_SCANNED;
+    sp->cScans++;
+    if (u == sink)
+      return true;
+
+    lastArc = arcs + graph->first[v + 1];
+    for (arc = arcs + graph->first[v]; arc < lastArc; arc++) {
+      if (!afFlagged(row, arc - arcs))
+	continue;
+      w = nodes + arc->head;
+      if (w->tStamp != sp->curTime)
+	sp->initNode(w);
+      newDist = u->dist + arc->len;
+      if (newDist < w->dist) {
+	w->dist = newDist;
+	parent[arc->head] = v;
+	if (w->where == IN_HEAP)
+	  queue->Decrease(arc->head, newDist);
+	else {
+	  queue->Push(arc->head, newDist);
+	  w->where = IN_HEAP;
+	}
+	sp->cUpdates++;
+      }
+    }
+  }
+  return false;
+}
+
+// builds (and writes, if params->afFile is set) or reads the flags
+ArcFlags *afLoad(CSRGraph *graph, int queueType, SPParams *params);
+
+#endif
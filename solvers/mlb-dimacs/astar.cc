@@ -0,0 +1,69 @@
+// astar.cc
+//     Setup of the coordinate lower bounds used by A* (astar.h).
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "astar.h"
+
+//-------------------------------------------------------------
+// CoordPotential::CoordPotential()
+//     scale is the largest factor by which coordinate distance can
+//     be multiplied and still not exceed the length of any arc.
+//     Then scale * distance(v, t) is a feasible lower bound on the
+//     length of a path from v to t, by the triangle inequality.
+//-------------------------------------------------------------
+
+CoordPotential::CoordPotential(CSRGraph *graphGiven)
+{
+  long v, a;
+  double d, ratio;
+  long long maxArcLen;
+
+  graph = graphGiven;
+  target = 0;
+  cosLat = NULL;
+  owner = true;
+  if (graph->x == NULL) {
+    fprintf(stderr, "ERROR: A* needs node coordinates (--co=<file>)\n");
+    exit(1);
+  }
+
+  if (graph->lonLat) {
+    cosLat = new double[graph->n];
+    for (v = 0; v < graph->n; v++)
+      cosLat[v] = cos(MICRODEG_TO_RAD * graph->y[v]);
+  }
+
+  scale = -1.0;
+  for (v = 0; v < graph->n; v++) {
+    for (a = graph->first[v]; a < graph->first[v + 1]; a++) {
+      d = Distance(v, csr_head(graph, a));
+      if (d > 0.0) {
+	ratio = (double) csr_len(graph, a) / d;
+	if (scale < 0.0 || ratio < scale)
+	  scale = ratio;
+      }
+    }
+  }
+  if (scale < 0.0)
+    scale = 0.0;                // no arc has any extent: plain Dijkstra
+  scale *= 1.0 - 1e-9;          // leave room for rounding errors
+
+  ArcLen(graph, NULL, &maxArcLen);
+  maxBound = maxArcLen * (graph->n - 1);
+}
+
+CoordPotential::~CoordPotential()
+{
+  if (cosLat && owner)
+    delete [] cosLat;
+}
+
+CoordPotential *CoordPotential::Clone()
+{
+  CoordPotential *clone = new CoordPotential(*this);
+
+  clone->owner = false;
+  return clone;
+}
@@ -0,0 +1,188 @@
+// astar.h
+//     Goal-directed point-to-point search (A*).  Dijkstra runs with
+//     key dist(v) + pi(v), where pi(v) is a lower bound on the
+//     distance from v to the sink supplied by a Potential class:
+//
+//       void Init(long t)       prepare bounds towards sink t
+//       long long Bound(long v) lower bound on dist(v, t)
+//
+//     The bound must be feasible (Bound(v) <= len(v,w) + Bound(w)
+//     for every arc), so every node is scanned at most once and the
+//     search can stop when the sink leaves the queue.  Bounds are
+//     computed once per query and node, on first touch.
+//
+//     CoordPotential measures the straight-line (or great-circle)
+//     distance to the sink and scales it by the smallest ratio of arc
+//     length to arc distance in the graph.  Queue is a heap wrapper
+//     with the interface used by bidir.h.  A Potential also has
+//
+//       Potential *Clone()      a copy for another thread, sharing
+//                               any tables with this one
+
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "sp.h"
+
+class CoordPotential {
+ private:
+   CSRGraph *graph;
+   double scale;              // min over arcs of length / distance
+   double *cosLat;            // lonLat graphs: cos of each latitude
+   long long maxBound;        // no distance is longer
+   long target;
+   bool owner;                // frees cosLat; false for clones
+
+   double Distance(long v, long w);
+ public:
+   CoordPotential(CSRGraph *graphGiven);
+   ~CoordPotential();
+   CoordPotential *Clone();
+   void Init(long t)                  { target = t; }
+   long long Bound(long v);
+};
+
+template <class Queue, class Potential>
+class AStarEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   Queue *queue;
+   Potential *potential;
+   long long *pi;             // pi[v] is valid if piTime[v] is current
+   unsigned int *piTime;
+
+   template <class Arc>
+   bool search(Node *source, Node *sink, SP *sp, const Arc *arcs);
+ public:
+   AStarEngine(CSRGraph *graphGiven, Potential *potentialGiven);
+   ~AStarEngine();
+   SPEngine *Clone(Node *)
+   {
+     return new AStarEngine(graph, potential->Clone());
+   }
+   bool run(Node *source, Node *sink, SP *sp);
+};
+
+//-------------------------------------------------------------
+// CoordPotential::Distance()
+//     Euclidean distance in the plane or, for longitude/latitude,
+//     the central angle given by the haversine formula.  Only the
+//     ratio to arc lengths matters, so the units do not.
+//-------------------------------------------------------------
+
+#define MICRODEG_TO_RAD      (3.14159265358979323846 / 180e6)
+
+inline double CoordPotential::Distance(long v, long w)
+{
+  double dx, dy, a;
+
+  if (!graph->lonLat) {
+    dx = (double) graph->x[v] - (double) graph->x[w];
+    dy = (double) graph->y[v] - (double) graph->y[w];
+    return sqrt(dx * dx + dy * dy);
+  }
+  dx = sin(0.5 * MICRODEG_TO_RAD * (graph->x[v] - graph->x[w]));
+  dy = sin(0.5 * MICRODEG_TO_RAD * (graph->y[v] - graph->y[w]));
+  a = dy * dy + cosLat[v] * cosLat[w] * dx * dx;
+  if (a > 1.0)
+    a = 1.0;
+  return 2.0 * asin(sqrt(a));
+}
+
+inline long long CoordPotential::Bound(long v)
+{
+  double b = scale * Distance(v, target);
+
+  if (b >= (double) maxBound)
+    return maxBound;
+  return (long long) b;      // rounding down keeps the bound feasible
+}
+
+template <class Queue, class Potential>
+AStarEngine<Queue, Potential>::AStarEngine(CSRGraph *graphGiven,
+					   Potential *potentialGiven)
+{
+  graph = graphGiven;
+  potential = potentialGiven;
+  queue = new Queue(graph);
+  pi = new long long[graph->n];
+  piTime = (unsigned int *) calloc(graph->n, sizeof(unsigned int));
+  if (piTime == NULL) {
+    fprintf(stderr, "ERROR: can't allocate potentials\n");
+    exit(1);
+  }
+}
+
+template <class Queue, class Potential>
+AStarEngine<Queue, Potential>::~AStarEngine()
+{
+  delete queue;
+  delete potential;
+  delete [] pi;
+  free(piTime);
+}
+
+template <class Queue, class Potential>
+bool AStarEngine<Queue, Potential>::run(Node *source, Node *sink, SP *sp)
+{
+  if (graph->arcs32 != NULL)
+    return search(source, sink, sp, graph->arcs32);
+  return search(source, sink, sp, graph->arcs);
+}
+
+template <class Queue, class Potential>
+template <class Arc>
+bool AStarEngine<Queue, Potential>::search(Node *source, Node *sink, SP *sp,
+					   const Arc *arcs)
+{
+  Node *nodes = sp->getNodes(), *u, *w;
+  long *parent = sp->getParents();
+  const Arc *arc, *lastArc;
+  long v;
+  long long newDist;
+
+  sp->curTime++;
+  source->tStamp = sp->curTime;     // initS has set dist and parent
+  potential->Init(sink - nodes);
+
+  queue->Clear();
+  queue->Push(source - nodes, potential->Bound(source - nodes));
+  source->where = IN_HEAP;
+
+  while ((v = queue->PopMin()) >= 0) {
+    u = nodes + v;
+    u->where = IN_SCANNED;
+    sp->cScans++;
+    if (u == sink)
+      return true;
+
+    lastArc = arcs + graph->first[v + 1];
+    for (arc = arcs + graph->first[v]; arc < lastArc; arc++) {
+      w = nodes + arc->head;
+      if (w->tStamp != sp->curTime)
+	sp->initNode(w);
+      newDist = u->dist + arc->len;
+      if (newDist < w->dist) {
+	w->dist = newDist;
+	parent[arc->head] = v;
+	if (piTime[arc->head] != sp->curTime) {
+	  pi[arc->head] = potential->Bound(arc->head);
+	  piTime[arc->head] = sp->curTime;
+	}
+	if (w->where == IN_HEAP)
+	  queue->Decrease(arc->head, newDist + pi[arc->head]);
+	else {
+	  queue->Push(arc->head, newDist + pi[arc->head]);
+	  w->where = IN_HEAP;
+	}
+	sp->cUpdates++;
+      }
+    }
+  }
+  return false;
+}
+
+#endif
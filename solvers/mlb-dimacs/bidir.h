@@ -0,0 +1,196 @@
+// bidir.h
+//     Bidirectional Dijkstra for point-to-point queries.  A forward
+//     search from the source over the graph and a backward search
+//     from the sink over graph->reverse take turns scanning one node
+//     each.  mu is the length of the best source-sink path seen so
+//     far (a node labeled by both searches); once the two queue
+//     minima add up to at least mu, no shorter path is left.
+//
+//     Queue is a heap wrapper (fiboheap.h, binheap.h) used through
+//     its Clear/Push/Decrease/PopMin/MinKey/IsEmpty interface; each
+//     direction has its own.  Forward labels and parents are SP's,
+//     backward ones are in a second pair of arrays owned by the
+//     engine.
+//     On return sink->dist is the source-sink distance and the
+//     parents from sink lead back along a shortest path.
+
+#ifndef BIDIR_H
+#define BIDIR_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "sp.h"
+
+template <class Queue>
+class BidirEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   Queue *queue[2];           // 0: forward, 1: backward
+   Node *rnodes;              // backward labels
+   long *rparent;             // and parents
+
+   template <class Arc>
+   void scan(int dir, long v, Node *label, Node *other,
+	     long long *mu, long *meet, SP *sp, const Arc *arcs);
+   void setPath(Node *nodes, long meet, SP *sp);
+ public:
+   BidirEngine(CSRGraph *graphGiven);
+   ~BidirEngine();
+   SPEngine *Clone(Node *)        { return new BidirEngine(graph); }
+   bool run(Node *source, Node *sink, SP *sp);
+};
+
+template <class Queue>
+BidirEngine<Queue>::BidirEngine(CSRGraph *graphGiven)
+{
+  graph = graphGiven;
+  if (graph->reverse == NULL) {
+    fprintf(stderr, "ERROR: bidirectional search needs the reverse graph\n");
+    exit(1);
+  }
+  queue[0] = new Queue(graph);
+  queue[1] = new Queue(graph->reverse);
+  // tStamp 0 is never current, so no label is valid yet
+  rnodes = (Node *) calloc(graph->n, sizeof(Node));
+  if (rnodes == NULL) {
+    fprintf(stderr, "ERROR: can't allocate backward labels\n");
+    exit(1);
+  }
+  rparent = new long[graph->n > 0 ? graph->n : 1];
+}
+
+template <class Queue>
+BidirEngine<Queue>::~BidirEngine()
+{
+  delete queue[0];
+  delete queue[1];
+  free(rnodes);
+  delete [] rparent;
+}
+
+//-------------------------------------------------------------
+// BidirEngine::scan()
+//     Scans v in direction dir: label is this direction's label
+//     array, other the opposite one.  A neighbor labeled by both
+//     searches closes a source-sink path and may improve mu; meet
+//     is then where the two halves of the best path join.  arcs
+//     are the arcs of that direction's graph in either layout.
+//-------------------------------------------------------------
+
+template <class Queue>
+template <class Arc>
+void BidirEngine<Queue>::scan(int dir, long v, Node *label, Node *other,
+			      long long *mu, long *meet, SP *sp,
+			      const Arc *arcs)
+{
+  CSRGraph *g = dir ? graph->reverse : graph;
+  Queue *q = queue[dir];
+  long *parent = dir ? rparent : sp->getParents();
+  const Arc *arc, *lastArc;
+  Node *u = label + v, *w;
+  long long newDist;
+
+  u->where = IN_SCANNED;
+  sp->cScans++;
+
+  lastArc = arcs + g->first[v + 1];
+  for (arc = arcs + g->first[v]; arc < lastArc; arc++) {
+    w = label + arc->head;
+    if (w->tStamp != sp->curTime)
+      sp->initNode(w);
+    newDist = u->dist + arc->len;
+    if (newDist < w->dist) {
+      w->dist = newDist;
+      parent[arc->head] = v;
+      if (w->where == IN_HEAP)
+	q->Decrease(arc->head, newDist);
+      else {
+	q->Push(arc->head, newDist);
+	w->where = IN_HEAP;
+      }
+      sp->cUpdates++;
+
+      if (other[arc->head].tStamp == sp->curTime &&
+	  newDist + other[arc->head].dist < *mu) {
+	*mu = newDist + other[arc->head].dist;
+	*meet = arc->head;
+      }
+    }
+  }
+}
+
+//-------------------------------------------------------------
+// BidirEngine::setPath()
+//     Copies the backward half of the path, meet .. sink, into the
+//     forward labels, so the parents from sink lead back to the
+//     source as in the other modes.  Both directions index nodes
+//     alike, so one index walks both label arrays.
+//-------------------------------------------------------------
+
+template <class Queue>
+void BidirEngine<Queue>::setPath(Node *nodes, long meet, SP *sp)
+{
+  long *parent = sp->getParents();
+  long u = meet, w;
+
+  while (rparent[u] != u) {
+    w = rparent[u];
+    if (nodes[w].tStamp != sp->curTime)
+      sp->initNode(nodes + w);
+    nodes[w].dist = nodes[u].dist + (rnodes[u].dist - rnodes[w].dist);
+    parent[w] = u;
+    u = w;
+  }
+}
+
+template <class Queue>
+bool BidirEngine<Queue>::run(Node *source, Node *sink, SP *sp)
+{
+  Node *nodes = sp->getNodes(), *rsink;
+  // the reverse always has the graph's layout (csr_add_reverse)
+  bool compact = (graph->arcs32 != NULL);
+  long long mu = VERY_FAR;
+  int dir;
+  long v, meet = -1;
+
+  sp->curTime++;
+  source->tStamp = sp->curTime;     // initS has set dist and parent
+  if (source == sink)
+    return true;
+
+  rsink = rnodes + (sink - nodes);
+  sp->initNode(rsink);
+  rsink->dist = 0;
+  rparent[sink - nodes] = sink - nodes;
+
+  queue[0]->Clear();
+  queue[1]->Clear();
+  queue[0]->Push(source - nodes, 0);
+  source->where = IN_HEAP;
+  queue[1]->Push(sink - nodes, 0);
+  rsink->where = IN_HEAP;
+
+  for (dir = 0;
+       !queue[0]->IsEmpty() && !queue[1]->IsEmpty() &&
+	 queue[0]->MinKey() + queue[1]->MinKey() < mu;
+       dir = 1 - dir) {
+    v = queue[dir]->PopMin();
+    if (compact) {
+      if (dir == 0)
+	scan(0, v, nodes, rnodes, &mu, &meet, sp, graph->arcs32);
+      else
+	scan(1, v, rnodes, nodes, &mu, &meet, sp, graph->reverse->arcs32);
+    }
+    else if (dir == 0)
+      scan(0, v, nodes, rnodes, &mu, &meet, sp, graph->arcs);
+    else
+      scan(1, v, rnodes, nodes, &mu, &meet, sp, graph->reverse->arcs);
+  }
+
+  if (mu == VERY_FAR)
+    return false;
+  setPath(nodes, meet, sp);
+  return true;
+}
+
+#endif
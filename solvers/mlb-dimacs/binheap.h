@@ -3,37 +3,38 @@
 
 #include "binheap_core.h"
 #include "nodearc.h"
-
+#include "csr.h"
 #include "sp.h" //get shortest path wrapper class
 
 #ifndef ulong
 typedef unsigned long ulong; // to get that extra bit
 #endif
 
-
-typedef struct BinArc;
-
-typedef BinNode<BinArc*> BinoNode;
-
-//with a dummy head, arc use only in fiboheap.
-typedef struct BinArc{
-    long long len;  //len of arc
-    BinoNode *head; //the conjunctive node
-    BinArc *next;   //NULL if no other edge
-} ;
-
+//a heap node only carries the index of its graph node in the CSR graph.
+//KeyType is int or long long, chosen by the driver from the largest
+//possible distance; instantiations live in binheap.cc.
+template <class KeyType>
 class BinoHeap_Wrapper{
+public:
+    typedef BinNode<long, KeyType> BinoNode;
 private:
-    BinHeap<BinArc *> * instance;
-    void initHeap(ulong N, Node *nodes);
+    BinHeap<long, KeyType> * instance;
+    CSRGraph *graph;  //shared, read-only
+    BinoNode *pool;   //pool[v] is the heap node of graph node v
 public:
-    BinoHeap_Wrapper(ulong N,Node *nodes);
+    BinoHeap_Wrapper(CSRGraph *graph);
 
     ~BinoHeap_Wrapper();
-    void dijkstra(Node *source, SP *sp);
     BinoNode *RemoveMin();
-    void reInit(ulong N, Node *nodes);
-    void printfStats();
+
+    //queue interface the searches run on (HeapEngine in engine.cc,
+    //bidir.h and the others); v is a node index, keys are distances
+    void Clear();
+    void Push(long v, long long key);
+    void Decrease(long v, long long key);
+    long PopMin();             //-1 if empty
+    long long MinKey();        //must not be empty
+    bool IsEmpty();
 };
 
 #endif
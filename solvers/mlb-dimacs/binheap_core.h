@@ -6,69 +6,73 @@
 
 #define nullptr NULL
 
-template <class ElementType>
+// KeyType is the priority type; pick the narrowest type that holds
+// every key the heap will see.
+template <class ElementType, class KeyType = int>
 struct BinNode
 {
     ElementType element; // element data
-    int key; // key value
-    bool visited; 
+    KeyType key; // key value
     int degree; // number of children
-    BinNode<ElementType>* child; // first child ptr
-    BinNode<ElementType>* parent; // parent ptr
-    BinNode<ElementType>* next; // next sibling ptr
+    BinNode<ElementType, KeyType>* child; // first child ptr
+    BinNode<ElementType, KeyType>* parent; // parent ptr
+    BinNode<ElementType, KeyType>* next; // next sibling ptr
 
     // Constructor.
-    BinNode(ElementType element, int key);
+    BinNode(ElementType element, KeyType key);
     BinNode();
     // Destructor.
     ~BinNode();
 };
 
-template <class ElementType>
+template <class ElementType, class KeyType = int>
 class BinHeap {
 private:
-    BinNode<ElementType>* m_root; // root of first tree
+    BinNode<ElementType, KeyType>* m_root; // root of first tree
 
     // Make node a child of root.
-    void MakeChild(BinNode<ElementType>* child, BinNode<ElementType>* root);
+    void MakeChild(BinNode<ElementType, KeyType>* child, BinNode<ElementType, KeyType>* root);
     
     // Merge two binheaps.
-    BinNode<ElementType>* MergeList(BinNode<ElementType>* h1, BinNode<ElementType>* h2);
+    BinNode<ElementType, KeyType>* MergeList(BinNode<ElementType, KeyType>* h1, BinNode<ElementType, KeyType>* h2);
 
     // Merge H1 and H2 and consolidate all trees with same degree.
-    BinNode<ElementType>* Combine(BinNode<ElementType>* h1, BinNode<ElementType>* h2);
+    BinNode<ElementType, KeyType>* Combine(BinNode<ElementType, KeyType>* h1, BinNode<ElementType, KeyType>* h2);
 
     // Reverse a binheap and reset their parent ptr, and then return the new head.
-    BinNode<ElementType>* Reverse(BinNode<ElementType>* root);
+    BinNode<ElementType, KeyType>* Reverse(BinNode<ElementType, KeyType>* root);
 
     // Remove min tree and return it.
-    BinNode<ElementType>* ExtractMin(BinNode<ElementType>* root);
+    BinNode<ElementType, KeyType>* ExtractMin(BinNode<ElementType, KeyType>* root);
 
-    // Remove node of key "int key" from list.
-    BinNode<ElementType>* Remove(BinNode<ElementType>* root, int key);
+    // Remove node of key "KeyType key" from list.
+    BinNode<ElementType, KeyType>* Remove(BinNode<ElementType, KeyType>* root, KeyType key);
 
-    // Find node of key "int key" in list return it.
-    BinNode<ElementType>* FindKey(BinNode<ElementType>* head, int key);
+    // Find node of key "KeyType key" in list return it.
+    BinNode<ElementType, KeyType>* FindKey(BinNode<ElementType, KeyType>* head, KeyType key);
 
     // Find node of element "ElementType element" in list return it.
-    BinNode<ElementType>* FindElement(BinNode<ElementType>* head, ElementType element);
+    BinNode<ElementType, KeyType>* FindElement(BinNode<ElementType, KeyType>* head, ElementType element);
 
-    // Increase key of node to "int key".
-    void IncreaseKey(BinNode<ElementType>* node, int key);
+    // Increase key of node to "KeyType key".
+    void IncreaseKey(BinNode<ElementType, KeyType>* node, KeyType key);
 
-    // Update key of node to "int key".
-    void UpdateKey(BinNode<ElementType>* node, int key);
+    // Update key of node to "KeyType key".
+    void UpdateKey(BinNode<ElementType, KeyType>* node, KeyType key);
+
+    // Exchange node with its parent, keeping element and key with the node.
+    void SwapWithParent(BinNode<ElementType, KeyType>* node);
 
     // Get min tree and its predecessor.
-    void GetMin(BinNode<ElementType>* root, BinNode<ElementType>*& prev_y, BinNode<ElementType>*& y);
+    void GetMin(BinNode<ElementType, KeyType>* root, BinNode<ElementType, KeyType>*& prev_y, BinNode<ElementType, KeyType>*& y);
     
     // Print node and all its siblings and children.
     // If flag = true, node is a first child.
     // If flag = false, node is a sibling.
-    void Print(BinNode<ElementType>* node, BinNode<ElementType>* prev, bool flag);
+    void Print(BinNode<ElementType, KeyType>* node, BinNode<ElementType, KeyType>* prev, bool flag);
 
     // Destroy node.
-    void DestroyNode(BinNode<ElementType>* node);
+    void DestroyNode(BinNode<ElementType, KeyType>* node);
 
 public:
     // Constructor.
@@ -77,41 +81,44 @@ public:
     // Destructor.
     ~BinHeap();
 
-    // Decrease key of node to "int key".
-    void DecreaseKey(BinNode<ElementType>* node, int key);
+    // Decrease key of node to "KeyType key".
+    void DecreaseKey(BinNode<ElementType, KeyType>* node, KeyType key);
 
 
     // Initialize a new node by element and key, then insert it into heap.
-    void Insert(ElementType element, int key);
-    void Insert(BinNode<ElementType>* node);
+    void Insert(ElementType element, KeyType key);
+    void Insert(BinNode<ElementType, KeyType>* node);
 
-    // Find node of key "int key" in heap.
-    BinNode<ElementType>* FindKey(int key);
+    // Find node of key "KeyType key" in heap.
+    BinNode<ElementType, KeyType>* FindKey(KeyType key);
 
     // Find node of element "ElementType element" in heap.
-    BinNode<ElementType>* FindElement(ElementType element);
+    BinNode<ElementType, KeyType>* FindElement(ElementType element);
 
     // Find node of key oldKey and then update it to newKey.
-    void Update(int oldkey, int newkey);
+    void Update(KeyType oldkey, KeyType newkey);
 
-    // Remove node of key "int key".
-    void Remove(int key);
+    // Remove node of key "KeyType key".
+    void Remove(KeyType key);
 
     // Remove min tree from heap.
     void RemoveMin();
 
     // Combine two binheaps.
-    void Combine(BinHeap<ElementType>* binheap);
+    void Combine(BinHeap<ElementType, KeyType>* binheap);
 
     // Get min tree.
-    BinNode<ElementType>* GetMin();
+    BinNode<ElementType, KeyType>* GetMin();
 
-    // Return whether there exists a node of key "int key".
-    bool Contains(int key);
+    // Return whether there exists a node of key "KeyType key".
+    bool Contains(KeyType key);
 
     // Print heap.
     void Print();
 
+    // Empty the heap in O(1); nodes still linked are simply dropped.
+    void Clear();
+
     // Destroy heap.
     void Destroy();
 };
@@ -119,23 +126,23 @@ public:
 // struct BinNode<class ElementType>
 
 // Constructor.
-template <class ElementType>
-BinNode<ElementType>::BinNode(ElementType element, int key) :element(element), key(key), degree(0), child(nullptr), parent(nullptr), next(nullptr) {}
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>::BinNode(ElementType element, KeyType key) :element(element), key(key), degree(0), child(nullptr), parent(nullptr), next(nullptr) {}
 
-template <class ElementType>
-BinNode<ElementType>::BinNode(): degree(0), child(nullptr), parent(nullptr), next(nullptr) {}
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>::BinNode(): degree(0), child(nullptr), parent(nullptr), next(nullptr) {}
 
 // Destructor.
-template <class ElementType>
-BinNode<ElementType>::~BinNode() {}
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>::~BinNode() {}
 
 // struct BinHeap<class ElementType>
 
 // Private:
 
 // Make node a child of root.
-template <class ElementType>
-void BinHeap<ElementType>::MakeChild(BinNode<ElementType>* node, BinNode<ElementType>* root)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::MakeChild(BinNode<ElementType, KeyType>* node, BinNode<ElementType, KeyType>* root)
 {
     node->parent = root;
     node->next = root->child;
@@ -144,11 +151,11 @@ void BinHeap<ElementType>::MakeChild(BinNode<ElementType>* node, BinNode<Element
 }
 
 // Merge two binheaps into a forest.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::MergeList(BinNode<ElementType>* H1, BinNode<ElementType>* H2)
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::MergeList(BinNode<ElementType, KeyType>* H1, BinNode<ElementType, KeyType>* H2)
 {
-    BinNode<ElementType>* root = nullptr; // root of combined binheap
-    BinNode<ElementType>** cur = &root; // ptr to node ptrs along the tree list
+    BinNode<ElementType, KeyType>* root = nullptr; // root of combined binheap
+    BinNode<ElementType, KeyType>** cur = &root; // ptr to node ptrs along the tree list
 
     // Insert sorted nodes from two heaps into new heap.
     while (H1 && H2)
@@ -177,19 +184,19 @@ BinNode<ElementType>* BinHeap<ElementType>::MergeList(BinNode<ElementType>* H1,
 }
 
 // Merge H1 and H2 and consolidate all trees with same degree.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::Combine(BinNode<ElementType>* H1, BinNode<ElementType>* H2)
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::Combine(BinNode<ElementType, KeyType>* H1, BinNode<ElementType, KeyType>* H2)
 {
     // Merge H1 and H2 into a new list.
-    BinNode<ElementType>* head = MergeList(H1, H2);
+    BinNode<ElementType, KeyType>* head = MergeList(H1, H2);
     if (head == nullptr)
         return nullptr;
 
     // Consolidate all trees with same degree.
 
-    BinNode<ElementType>* pre = nullptr; // predecessor of current
-    BinNode<ElementType>* cur = head; // current
-    BinNode<ElementType>* suc = cur->next; // successor of current
+    BinNode<ElementType, KeyType>* pre = nullptr; // predecessor of current
+    BinNode<ElementType, KeyType>* cur = head; // current
+    BinNode<ElementType, KeyType>* suc = cur->next; // successor of current
 
     // Traverse the list and consolidate all nodes with same degree.
     while (suc != nullptr)
@@ -228,11 +235,11 @@ BinNode<ElementType>* BinHeap<ElementType>::Combine(BinNode<ElementType>* H1, Bi
 }
 
 // Reverse a binheap and reset their parent ptr, and then return the new head.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::Reverse(BinNode<ElementType>* head)
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::Reverse(BinNode<ElementType, KeyType>* head)
 {
-    BinNode<ElementType>* next; // head's next
-    BinNode<ElementType>* tail = nullptr; // tail of new list
+    BinNode<ElementType, KeyType>* next; // head's next
+    BinNode<ElementType, KeyType>* tail = nullptr; // tail of new list
 
     // If list is empty, return nullptr.
     if (head == nullptr)
@@ -254,10 +261,10 @@ BinNode<ElementType>* BinHeap<ElementType>::Reverse(BinNode<ElementType>* head)
 }
 
 // Remove min tree and return it.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::ExtractMin(BinNode<ElementType>* head)
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::ExtractMin(BinNode<ElementType, KeyType>* head)
 {
-    BinNode<ElementType>* min, * pre; // min tree and its predecessor.
+    BinNode<ElementType, KeyType>* min, * pre; // min tree and its predecessor.
 
     if (head == nullptr)
         return head;
@@ -279,21 +286,21 @@ BinNode<ElementType>* BinHeap<ElementType>::ExtractMin(BinNode<ElementType>* hea
     return head;
 }
 
-// Remove node of key "int key" from list.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::Remove(BinNode<ElementType>* head, int key)
+// Remove node of key "KeyType key" from list.
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::Remove(BinNode<ElementType, KeyType>* head, KeyType key)
 {
     if (head == nullptr)
         return head;
 
-    BinNode<ElementType>* node = FindKey(head, key); // node of key "int key"
+    BinNode<ElementType, KeyType>* node = FindKey(head, key); // node of key "KeyType key"
 
-    // If can't find node of key "int key", return.
+    // If can't find node of key "KeyType key", return.
     if (node == nullptr)
         return head;
 
     // Upsurge node to root.
-    BinNode<ElementType>*  parent = node->parent;
+    BinNode<ElementType, KeyType>*  parent = node->parent;
     while (parent != nullptr)
     {
         // Swap data.
@@ -305,8 +312,8 @@ BinNode<ElementType>* BinHeap<ElementType>::Remove(BinNode<ElementType>* head, i
     }
 
     // Find predecessor of node.
-    BinNode<ElementType>* pre = nullptr;
-    BinNode<ElementType>* cur = head;
+    BinNode<ElementType, KeyType>* pre = nullptr;
+    BinNode<ElementType, KeyType>* cur = head;
     while (cur != node)
     {
         pre = cur;
@@ -327,12 +334,12 @@ BinNode<ElementType>* BinHeap<ElementType>::Remove(BinNode<ElementType>* head, i
     return head;
 }
 
-// Find node of key "int key" in list return it.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::FindKey(BinNode<ElementType>* head, int key)
+// Find node of key "KeyType key" in list return it.
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::FindKey(BinNode<ElementType, KeyType>* head, KeyType key)
 {
-    BinNode<ElementType>* child = nullptr;
-    BinNode<ElementType>* parent = head;
+    BinNode<ElementType, KeyType>* child = nullptr;
+    BinNode<ElementType, KeyType>* parent = head;
 
     while (parent != nullptr)
     {
@@ -352,11 +359,11 @@ BinNode<ElementType>* BinHeap<ElementType>::FindKey(BinNode<ElementType>* head,
 }
 
 // Find node of element "ElementType element" in list return it.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::FindElement(BinNode<ElementType>* head, ElementType element)
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::FindElement(BinNode<ElementType, KeyType>* head, ElementType element)
 {
-    BinNode<ElementType>* child = nullptr;
-    BinNode<ElementType>* parent = head;
+    BinNode<ElementType, KeyType>* child = nullptr;
+    BinNode<ElementType, KeyType>* parent = head;
 
     while (parent != nullptr)
     {
@@ -375,9 +382,9 @@ BinNode<ElementType>* BinHeap<ElementType>::FindElement(BinNode<ElementType>* he
     return nullptr;
 }
 
-// Find node of key "int key" in heap.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::FindKey(int key)
+// Find node of key "KeyType key" in heap.
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::FindKey(KeyType key)
 {
     if(m_root == nullptr)
         return nullptr;
@@ -386,8 +393,8 @@ BinNode<ElementType>* BinHeap<ElementType>::FindKey(int key)
 }
 
 // Find node of element "ElementType element" in heap.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::FindElement(ElementType element)
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::FindElement(ElementType element)
 {
     if (m_root == nullptr)
         return nullptr;
@@ -395,9 +402,9 @@ BinNode<ElementType>* BinHeap<ElementType>::FindElement(ElementType element)
     return FindElement(m_root, element);
 }
 
-// Increase key of node to "int key".
-template <class ElementType>
-void BinHeap<ElementType>::IncreaseKey(BinNode<ElementType>* node, int key)
+// Increase key of node to "KeyType key".
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::IncreaseKey(BinNode<ElementType, KeyType>* node, KeyType key)
 {
     // If increase fails, return.
     if (key <= node->key || Contains(key))
@@ -407,15 +414,15 @@ void BinHeap<ElementType>::IncreaseKey(BinNode<ElementType>* node, int key)
     node->key = key;
 
     // Keep min heap.
-    BinNode<ElementType>* cur = node;
-    BinNode<ElementType>* child = cur->child;
+    BinNode<ElementType, KeyType>* cur = node;
+    BinNode<ElementType, KeyType>* child = cur->child;
     while (child != nullptr)
     {
         // If violates min heap law, adjust heap.
         if (cur->key > child->key)
         {
             // Find min descendant and swap.
-            BinNode<ElementType>* least = child;
+            BinNode<ElementType, KeyType>* least = child;
             while (child->next != nullptr)
             {
                 if (least->key > child->next->key)
@@ -438,31 +445,68 @@ void BinHeap<ElementType>::IncreaseKey(BinNode<ElementType>* node, int key)
     }
 }
 
-// Decrease key of node to "int key".
-template <class ElementType>
-void BinHeap<ElementType>::DecreaseKey(BinNode<ElementType>* node, int key)
+// Decrease key of node to "KeyType key".
+// Nodes move up by relinking rather than by swapping keys, so a
+// caller holding a node pointer keeps pointing at the same element.
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::DecreaseKey(BinNode<ElementType, KeyType>* node, KeyType key)
 {
     // If decrease fails, return.
-    if (key >= node->key || Contains(key))
+    if (key >= node->key)
        return;
 
     // Decrease.
     node->key = key;
 
     // Upsurge node to keep a min heap.
-    BinNode<ElementType>* child = node;
-    BinNode<ElementType>* parent = node->parent;
-    while (parent != nullptr && child->key < parent->key)
-    {
-        std::swap(parent->key, child->key);
-        child = parent;
-        parent = child->parent;
-    }
+    while (node->parent != nullptr && node->key < node->parent->key)
+        SwapWithParent(node);
+}
+
+// Exchange node with its parent in the tree structure.
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::SwapWithParent(BinNode<ElementType, KeyType>* node)
+{
+    BinNode<ElementType, KeyType>* parent = node->parent;
+    BinNode<ElementType, KeyType>** pslot; // link pointing to parent
+    BinNode<ElementType, KeyType>** nslot; // link pointing to node
+    BinNode<ElementType, KeyType>* tmp;
+    int degree;
+
+    // Find the links to parent (root list or grandparent's children)
+    // and to node (parent's children).  Both lists are O(log n) long.
+    pslot = (parent->parent == nullptr) ? &m_root : &parent->parent->child;
+    while (*pslot != parent)
+        pslot = &(*pslot)->next;
+    nslot = &parent->child;
+    while (*nslot != node)
+        nslot = &(*nslot)->next;
+
+    // Parent takes node's place among the siblings.
+    *nslot = parent;
+    tmp = parent->next;
+    parent->next = node->next;
+    node->next = tmp;
+
+    // Node takes parent's place; children and degrees are exchanged.
+    *pslot = node;
+    tmp = parent->child;
+    parent->child = node->child;
+    node->child = tmp;
+    degree = parent->degree;
+    parent->degree = node->degree;
+    node->degree = degree;
+    node->parent = parent->parent;
+
+    for (tmp = node->child; tmp != nullptr; tmp = tmp->next)
+        tmp->parent = node;
+    for (tmp = parent->child; tmp != nullptr; tmp = tmp->next)
+        tmp->parent = parent;
 }
 
-// Update key of node to "int key".
-template <class ElementType>
-void BinHeap<ElementType>::UpdateKey(BinNode<ElementType>* node, int key)
+// Update key of node to "KeyType key".
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::UpdateKey(BinNode<ElementType, KeyType>* node, KeyType key)
 {
     if (node == nullptr)
         return;
@@ -474,16 +518,16 @@ void BinHeap<ElementType>::UpdateKey(BinNode<ElementType>* node, int key)
 }
 
 // Get min tree and its predecessor.
-template <class ElementType>
-void BinHeap<ElementType>::GetMin(BinNode<ElementType>* head, BinNode<ElementType>*& preMin, BinNode<ElementType>*& min)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::GetMin(BinNode<ElementType, KeyType>* head, BinNode<ElementType, KeyType>*& preMin, BinNode<ElementType, KeyType>*& min)
 {
     // If list is empty, return.
     if (head == nullptr)
         return;
 
     // Initialization.
-    BinNode<ElementType>* preCur = head; // predecessor of current
-    BinNode<ElementType>* cur = head->next; // current
+    BinNode<ElementType, KeyType>* preCur = head; // predecessor of current
+    BinNode<ElementType, KeyType>* cur = head->next; // current
     preMin = nullptr;
     min = head;
 
@@ -503,8 +547,8 @@ void BinHeap<ElementType>::GetMin(BinNode<ElementType>* head, BinNode<ElementTyp
 // Print node and all its siblings and children.
 // If flag = true, node is a first child.
 // If flag = false, node is a sibling.
-template <class ElementType>
-void BinHeap<ElementType>::Print(BinNode<ElementType>* node, BinNode<ElementType>* pred, bool flag)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Print(BinNode<ElementType, KeyType>* node, BinNode<ElementType, KeyType>* pred, bool flag)
 {
     while (node != nullptr)
     {
@@ -526,10 +570,10 @@ void BinHeap<ElementType>::Print(BinNode<ElementType>* node, BinNode<ElementType
 }
 
 // Destroy node.
-template <class ElementType>
-void BinHeap<ElementType>::DestroyNode(BinNode<ElementType>* node)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::DestroyNode(BinNode<ElementType, KeyType>* node)
 {
-    BinNode<ElementType>* suc;
+    BinNode<ElementType, KeyType>* suc;
 
     while (node != nullptr)
     {
@@ -543,77 +587,77 @@ void BinHeap<ElementType>::DestroyNode(BinNode<ElementType>* node)
 // Public:
 
 // Constructor.
-template <class ElementType>
-BinHeap<ElementType>::BinHeap() :m_root(nullptr) {}
+template <class ElementType, class KeyType>
+BinHeap<ElementType, KeyType>::BinHeap() :m_root(nullptr) {}
 
 // Destructor.
-template <class ElementType>
-BinHeap<ElementType>::~BinHeap() {}
+template <class ElementType, class KeyType>
+BinHeap<ElementType, KeyType>::~BinHeap() {}
 
 // Initialize a new node by element and key, then insert it into heap.
-template <class ElementType>
-void BinHeap<ElementType>::Insert(ElementType element, int key)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Insert(ElementType element, KeyType key)
 {
-    BinNode<ElementType>* node = new BinNode<ElementType>(element, key);
+    BinNode<ElementType, KeyType>* node = new BinNode<ElementType, KeyType>(element, key);
     m_root = Combine(m_root, node);
 }
-template <class ElementType>
-void BinHeap<ElementType>::Insert(BinNode<ElementType>* node){
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Insert(BinNode<ElementType, KeyType>* node){
     m_root = Combine(m_root, node);
 }
 
 // Find node of key oldKey and then update it to newKey.
-template <class ElementType>
-void BinHeap<ElementType>::Update(int oldKey, int newKey)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Update(KeyType oldKey, KeyType newKey)
 {
-    BinNode<ElementType>* node = FindKey(m_root, oldKey);
+    BinNode<ElementType, KeyType>* node = FindKey(m_root, oldKey);
     if (node != nullptr)
         UpdateKey(node, newKey);
 }
 
-// Remove node of key "int key".
-template <class ElementType>
-void BinHeap<ElementType>::Remove(int key)
+// Remove node of key "KeyType key".
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Remove(KeyType key)
 {
     m_root = Remove(m_root, key);
 }
 
 // Remove min tree from heap.
-template <class ElementType>
-void BinHeap<ElementType>::RemoveMin()
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::RemoveMin()
 {
     m_root = ExtractMin(m_root);
 }
 
 // Combine two binheaps.
-template <class ElementType>
-void BinHeap<ElementType>::Combine(BinHeap<ElementType>* binheap)
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Combine(BinHeap<ElementType, KeyType>* binheap)
 {
     if (binheap != nullptr && binheap->m_root != nullptr)
         m_root = Combine(m_root, binheap->m_root);
 }
 
 // Get min tree.
-template <class ElementType>
-BinNode<ElementType>* BinHeap<ElementType>::GetMin()
+template <class ElementType, class KeyType>
+BinNode<ElementType, KeyType>* BinHeap<ElementType, KeyType>::GetMin()
 {
-    BinNode<ElementType>* pre=NULL, * min=NULL;
+    BinNode<ElementType, KeyType>* pre=NULL, * min=NULL;
     GetMin(m_root, pre, min);
     return min;
 }
 
-// Return whether there exists a node of key "int key".
-template <class ElementType>
-bool BinHeap<ElementType>::Contains(int key)
+// Return whether there exists a node of key "KeyType key".
+template <class ElementType, class KeyType>
+bool BinHeap<ElementType, KeyType>::Contains(KeyType key)
 {
     return FindKey(m_root, key) != nullptr ? true : false;
 }
 
 // Print heap.
-template <class ElementType>
-void BinHeap<ElementType>::Print()
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Print()
 {
-    BinNode<ElementType>* p;
+    BinNode<ElementType, KeyType>* p;
     if (m_root == nullptr)
         return;
 
@@ -640,9 +684,16 @@ void BinHeap<ElementType>::Print()
     std::cout << std::endl;
 }
 
+// Empty the heap.  Callers reinitialize a node before inserting it again.
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Clear()
+{
+    m_root = nullptr;
+}
+
 // Destroy heap.
-template <class ElementType>
-void BinHeap<ElementType>::Destroy()
+template <class ElementType, class KeyType>
+void BinHeap<ElementType, KeyType>::Destroy()
 {
     DestroyNode(m_root);
 }
@@ -0,0 +1,146 @@
+// caliber.h
+//     Dijkstra with any heap wrapper plus the caliber heuristic of
+//     smart queues (smartq.cc).  The caliber of a node is the length
+//     of its shortest incoming arc, and mu is the key last removed
+//     from the heap; no label is below mu.  A node labeled d <= mu +
+//     caliber can thus not improve any more: whatever reaches it
+//     later is at least mu away, plus an arc of at least its
+//     caliber.  Such a node goes on the stack F instead of the heap,
+//     and F is emptied before the heap is asked again.
+//
+//     The heap has no delete, so a node already in the heap when
+//     it qualifies for F leaves its entry behind; the entry is
+//     skipped when it comes out.  Calibers are built once per
+//     graph (csr_add_calibers) and shared by all engines.
+//
+//     Queue is a heap wrapper used through its Clear/Push/Decrease/
+//     PopMin interface, as in bidir.h.
+
+#ifndef CALIBER_H
+#define CALIBER_H
+
+#include <stdio.h>
+#include "sp.h"
+
+template <class Queue>
+class CaliberEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   Queue *heap;
+   Stack *F;                  // nodes whose distances are exact
+   long long statF;           // nodes settled through F
+   long long statHeap;        // nodes settled through the heap
+
+   template <bool SinglePair, class Arc>
+   bool dijkstra(Node *source, Node *sink, SP *sp, const Arc *arcs);
+ public:
+   CaliberEngine(CSRGraph *graphGiven);
+   ~CaliberEngine();
+   SPEngine *Clone(Node *)        { return new CaliberEngine(graph); }
+   bool run(Node *source, Node *sink, SP *sp);
+   void PrintStats(long tries);
+};
+
+template <class Queue>
+CaliberEngine<Queue>::CaliberEngine(CSRGraph *graphGiven)
+{
+  graph = graphGiven;
+  csr_add_calibers(graph);
+  heap = new Queue(graph);
+  F = new Stack(graph->n > 0 ? graph->n : 1);
+  statF = statHeap = 0;
+}
+
+template <class Queue>
+CaliberEngine<Queue>::~CaliberEngine()
+{
+  delete heap;
+  delete F;
+}
+
+template <class Queue>
+bool CaliberEngine<Queue>::run(Node *source, Node *sink, SP *sp)
+{
+  if (graph->arcs32 != NULL) {
+    if (sink == NULL)
+      return dijkstra<false>(source, NULL, sp, graph->arcs32);
+    return dijkstra<true>(source, sink, sp, graph->arcs32);
+  }
+  if (sink == NULL)
+    return dijkstra<false>(source, NULL, sp, graph->arcs);
+  return dijkstra<true>(source, sink, sp, graph->arcs);
+}
+
+template <class Queue>
+void CaliberEngine<Queue>::PrintStats(long tries)
+{
+  fprintf(stderr, "c From F (ave): %18.1f     From heap (ave): %13.1f\n",
+	  (float) statF / (float) tries, (float) statHeap / (float) tries);
+}
+
+template <class Queue>
+template <bool SinglePair, class Arc>
+bool CaliberEngine<Queue>::dijkstra(Node *source, Node *sink, SP *sp,
+				    const Arc *arcs)
+{
+  const long long *caliber = graph->caliber;
+  const Arc *arc, *lastArc;
+  Node *nodes = sp->getNodes(), *u, *w;
+  long *parent = sp->getParents();
+  long long mu = 0, newDist;
+  long v;
+
+  sp->curTime++;
+  heap->Clear();                  // leftovers of the last query are dropped
+  F->Clear();
+  source->tStamp = sp->curTime;
+  source->where = IN_F;
+  F->Push(source);
+
+  for (;;) {
+    if (!F->IsEmpty()) {
+      u = (Node *) F->Pop();
+      statF++;
+    }
+    else {
+      if ((v = heap->PopMin()) < 0)
+	break;
+      u = nodes + v;
+      if (u->where != IN_HEAP)    // went to F since, and is scanned
+	continue;
+      mu = u->dist;
+      statHeap++;
+    }
+    u->where = IN_SCANNED;
+    if (SinglePair && u == sink)
+      return true;
+    sp->cScans++;
+
+    // scan node
+    lastArc = arcs + graph->first[u - nodes + 1];
+    for (arc = arcs + graph->first[u - nodes]; arc < lastArc; arc++) {
+      w = nodes + arc->head;
+      if (w->tStamp != sp->curTime)
+	sp->initNode(w);          // first touch in this query
+      newDist = u->dist + arc->len;
+      if (newDist < w->dist) {
+	w->dist = newDist;
+	parent[arc->head] = u - nodes;
+	if (newDist <= mu + caliber[arc->head]) {
+	  w->where = IN_F;        // exact; any heap entry goes stale
+	  F->Push(w);
+	}
+	else if (w->where == IN_HEAP)
+	  heap->Decrease(arc->head, newDist);
+	else {
+	  heap->Push(arc->head, newDist);
+	  w->where = IN_HEAP;
+	}
+	sp->cUpdates++;
+      }
+    }
+  }
+  return !SinglePair;             // ran dry before reaching the sink
+}
+
+#endif
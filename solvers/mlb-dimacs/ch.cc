@@ -0,0 +1,667 @@
+// ch.cc
+//     Contraction Hierarchies preprocessing and the hierarchy file
+//     (see ch.h).
+//
+//     Nodes are contracted in rounds.  Each round takes the nodes
+//     whose priority is smaller than that of all their remaining
+//     neighbors; no two of them are adjacent, so their witness
+//     searches can run in parallel as long as they ignore each other.
+//     The shortcuts are then applied, and the priorities of the
+//     neighbors of contracted nodes, the only ones that may have
+//     changed much, are recomputed lazily at the start of the next
+//     round.
+//
+//     The priority of v is its edge difference (shortcuts contracting
+//     v would add, less the arcs it would remove) plus the number of
+//     its neighbors contracted already, which spreads contraction
+//     evenly over the graph.
+//
+//     A witness search from u looks for u-w paths avoiding v that are
+//     no longer than u->v->w, for all out-neighbors w of v at once.
+//     It stops when all of them are settled, gives up after
+//     CH_SETTLE_LIMIT settled nodes and does not extend paths beyond
+//     CH_HOP_LIMIT arcs; a shortcut without a witness is then added,
+//     which is never wrong, only sometimes unnecessary.  Priorities
+//     only estimate the shortcuts, with the cheaper
+//     CH_SIM_SETTLE_LIMIT.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "ch.h"
+
+typedef struct CHDynArc {
+  long other;            // head of an out arc, tail of an in arc
+  long long len;
+  long mid;
+} CHDynArc;
+
+typedef std::vector<CHDynArc> CHArcList;
+
+typedef struct CHShortcut {
+  long tail, head;
+  long long len;
+} CHShortcut;
+
+//-------------------------------------------------------------
+// CHWitness
+//     One thread's witness search state.
+//-------------------------------------------------------------
+
+#define CH_NONE      0
+#define CH_QUEUED    1
+#define CH_SETTLED   2
+
+template <class Queue>
+struct CHWitness {
+  Queue *queue;
+  long long *dist;
+  int *hops;
+  char *state;
+  unsigned int *stamp;   // the rest is valid if stamp[v] == time
+  unsigned int *target;  // out-neighbor of v if target[w] == time
+  unsigned int time;
+};
+
+template <class Queue>
+struct CHBuilder {
+  long n;
+  CHArcList *adj[2];     // 0: out arcs, 1: in arcs, of remaining nodes
+  bool *contracted;
+  bool *inRound;         // being contracted this round
+  bool *dirty;           // priority must be recomputed
+  long *deleted;         // contracted neighbors
+  long long *priority;
+  CHWitness<Queue> *witness;       // one per thread
+
+  // work of the current parallel step
+  pthread_mutex_t lock;
+  long next;
+  std::vector<long> *work;
+  std::vector<CHShortcut> *shortcuts;   // per entry of work, or NULL
+};
+
+template <class Queue>
+static void chWitnessInit(CHWitness<Queue> *w, CSRGraph *graph)
+{
+  w->queue = new Queue(graph);
+  w->dist = new long long[graph->n];
+  w->hops = new int[graph->n];
+  w->state = new char[graph->n];
+  w->stamp = new unsigned int[graph->n];
+  w->target = new unsigned int[graph->n];
+  memset(w->stamp, 0, graph->n * sizeof(unsigned int));
+  memset(w->target, 0, graph->n * sizeof(unsigned int));
+  w->time = 0;
+}
+
+template <class Queue>
+static void chWitnessFree(CHWitness<Queue> *w)
+{
+  delete w->queue;
+  delete [] w->dist;
+  delete [] w->hops;
+  delete [] w->state;
+  delete [] w->stamp;
+  delete [] w->target;
+}
+
+//-------------------------------------------------------------
+// chWitnessSearch()
+//     Dijkstra from u over the remaining graph, skipping v and the
+//     nodes contracted this round, up to distance maxDist and at
+//     most settleLimit settled nodes.
+//-------------------------------------------------------------
+
+template <class Queue>
+static void chWitnessSearch(CHBuilder<Queue> *b, CHWitness<Queue> *w,
+			    long u, long v, long long maxDist,
+			    long settleLimit)
+{
+  CHArcList::const_iterator arc;
+  long x, y;
+  long settled = 0, cTargets = 0;
+  long long d;
+
+  w->time++;
+  for (arc = b->adj[0][v].begin(); arc != b->adj[0][v].end(); ++arc)
+    if (arc->other != u && w->target[arc->other] != w->time) {
+      w->target[arc->other] = w->time;
+      cTargets++;
+    }
+  w->queue->Clear();
+  w->stamp[u] = w->time;
+  w->dist[u] = 0;
+  w->hops[u] = 0;
+  w->state[u] = CH_QUEUED;
+  w->queue->Push(u, 0);
+
+  while (!w->queue->IsEmpty() && w->queue->MinKey() <= maxDist &&
+	 settled < settleLimit) {
+    x = w->queue->PopMin();
+    w->state[x] = CH_SETTLED;
+    settled++;
+    if (w->target[x] == w->time && --cTargets == 0)
+      break;
+    if (w->hops[x] >= CH_HOP_LIMIT)
+      continue;
+
+    for (arc = b->adj[0][x].begin(); arc != b->adj[0][x].end(); ++arc) {
+      y = arc->other;
+      if (y == v || b->inRound[y])
+	continue;
+      d = w->dist[x] + arc->len;
+      if (w->stamp[y] != w->time) {
+	w->stamp[y] = w->time;
+	w->state[y] = CH_NONE;
+      }
+      if (w->state[y] == CH_NONE) {
+	w->dist[y] = d;
+	w->hops[y] = w->hops[x] + 1;
+	w->state[y] = CH_QUEUED;
+	w->queue->Push(y, d);
+      }
+      else if (w->state[y] == CH_QUEUED && d < w->dist[y]) {
+	w->dist[y] = d;
+	w->hops[y] = w->hops[x] + 1;
+	w->queue->Decrease(y, d);
+      }
+    }
+  }
+}
+
+//-------------------------------------------------------------
+// chContract()
+//     Finds the shortcuts contracting v needs; stores them if out
+//     is not NULL.  Returns their number.
+//-------------------------------------------------------------
+
+template <class Queue>
+static long chContract(CHBuilder<Queue> *b, CHWitness<Queue> *w, long v,
+		       std::vector<CHShortcut> *out)
+{
+  CHArcList::const_iterator in, arc;
+  long long maxOut, maxDist, viaV;
+  long cShortcuts = 0;
+  CHShortcut sc;
+
+  maxOut = 0;
+  for (arc = b->adj[0][v].begin(); arc != b->adj[0][v].end(); ++arc)
+    if (arc->len > maxOut)
+      maxOut = arc->len;
+
+  for (in = b->adj[1][v].begin(); in != b->adj[1][v].end(); ++in) {
+    maxDist = in->len + maxOut;
+    chWitnessSearch(b, w, in->other, v, maxDist,
+		    out ? CH_SETTLE_LIMIT : CH_SIM_SETTLE_LIMIT);
+
+    for (arc = b->adj[0][v].begin(); arc != b->adj[0][v].end(); ++arc) {
+      if (arc->other == in->other)
+	continue;
+      viaV = in->len + arc->len;
+      if (w->stamp[arc->other] == w->time &&
+	  w->dist[arc->other] <= viaV)
+	continue;                       // witness found
+      cShortcuts++;
+      if (out) {
+	sc.tail = in->other;
+	sc.head = arc->other;
+	sc.len = viaV;
+	out->push_back(sc);
+      }
+    }
+  }
+  return cShortcuts;
+}
+
+template <class Queue>
+static void chPriority(CHBuilder<Queue> *b, CHWitness<Queue> *w, long v)
+{
+  long edgeDiff = chContract(b, w, v, (std::vector<CHShortcut> *) NULL)
+    - (long) (b->adj[0][v].size() + b->adj[1][v].size());
+
+  b->priority[v] = edgeDiff + b->deleted[v];
+  b->dirty[v] = false;
+}
+
+//-------------------------------------------------------------
+// Parallel steps
+//     Threads take entries of b->work from a shared counter and
+//     either compute their priority (shortcuts NULL) or find their
+//     shortcuts.
+//-------------------------------------------------------------
+
+template <class Queue>
+struct CHThread {
+  CHBuilder<Queue> *b;
+  int id;
+};
+
+#define CH_CHUNK     64                // entries taken at a time
+
+template <class Queue>
+static void *chRunWork(void *arg)
+{
+  CHThread<Queue> *thread = (CHThread<Queue> *) arg;
+  CHBuilder<Queue> *b = thread->b;
+  CHWitness<Queue> *w = b->witness + thread->id;
+  long i, first, last, size = (long) b->work->size();
+
+  for (;;) {
+    pthread_mutex_lock(&b->lock);
+    first = b->next;
+    b->next += CH_CHUNK;
+    pthread_mutex_unlock(&b->lock);
+    if (first >= size)
+      break;
+    last = first + CH_CHUNK < size ? first + CH_CHUNK : size;
+
+    for (i = first; i < last; i++)
+      if (b->shortcuts)
+	chContract(b, w, (*b->work)[i], b->shortcuts + i);
+      else
+	chPriority(b, w, (*b->work)[i]);
+  }
+  return NULL;
+}
+
+template <class Queue>
+static void chParallel(CHBuilder<Queue> *b, int threads)
+{
+  CHThread<Queue> *thread;
+  pthread_t *tid;
+  int t, cThreads = threads;
+
+  if (cThreads > (long) b->work->size() / CH_CHUNK + 1)
+    cThreads = (long) b->work->size() / CH_CHUNK + 1;
+  b->next = 0;
+
+  thread = new CHThread<Queue>[cThreads];
+  tid = new pthread_t[cThreads];
+  for (t = 0; t < cThreads; t++) {
+    thread[t].b = b;
+    thread[t].id = t;
+  }
+  // the calling thread is thread 0
+  for (t = 1; t < cThreads; t++)
+    if (pthread_create(tid + t, NULL, chRunWork<Queue>, thread + t) != 0) {
+      fprintf(stderr, "ERROR: can't start a preprocessing thread\n");
+      exit(1);
+    }
+  chRunWork<Queue>(thread);
+  for (t = 1; t < cThreads; t++)
+    pthread_join(tid[t], NULL);
+
+  delete [] thread;
+  delete [] tid;
+}
+
+// adds tail->head, or shortens the existing arc
+static void chAddArc(CHArcList *adj[2], long tail, long head, long long len,
+		     long mid)
+{
+  CHArcList::iterator arc;
+  CHDynArc a;
+
+  for (arc = adj[0][tail].begin(); arc != adj[0][tail].end(); ++arc)
+    if (arc->other == head) {
+      if (arc->len > len) {
+	arc->len = len;
+	arc->mid = mid;
+	for (arc = adj[1][head].begin(); arc->other != tail; ++arc) ;
+	arc->len = len;
+	arc->mid = mid;
+      }
+      return;
+    }
+
+  a.len = len;
+  a.mid = mid;
+  a.other = head;
+  adj[0][tail].push_back(a);
+  a.other = tail;
+  adj[1][head].push_back(a);
+}
+
+static void chRemoveArc(CHArcList *list, long other)
+{
+  CHArcList::iterator arc;
+
+  for (arc = list->begin(); arc != list->end(); ++arc)
+    if (arc->other == other) {
+      *arc = list->back();
+      list->pop_back();
+      return;
+    }
+}
+
+// whether v goes before its neighbor u; ties by index
+template <class Queue>
+static inline bool chBefore(CHBuilder<Queue> *b, long v, long u)
+{
+  return b->priority[v] < b->priority[u] ||
+    (b->priority[v] == b->priority[u] && v < u);
+}
+
+static CHUp chMakeUp(long n, std::vector<CHDynArc> *arcs)
+{
+  CHUp up;
+  long v, i;
+
+  up.first = (long *) malloc((n + 1) * sizeof(long));
+  up.first[0] = 0;
+  for (v = 0; v < n; v++)
+    up.first[v + 1] = up.first[v] + (long) arcs[v].size();
+  up.m = up.first[n];
+  up.arcs = (CHArc *) malloc((up.m + 1) * sizeof(CHArc));
+  if (up.first == NULL || up.arcs == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the hierarchy\n");
+    exit(1);
+  }
+  for (v = 0; v < n; v++)
+    for (i = 0; i < (long) arcs[v].size(); i++) {
+      up.arcs[up.first[v] + i].len = arcs[v][i].len;
+      up.arcs[up.first[v] + i].head = arcs[v][i].other;
+      up.arcs[up.first[v] + i].mid = arcs[v][i].mid;
+    }
+  return up;
+}
+
+template <class Queue>
+CHGraph *chBuild(CSRGraph *graph, int threads)
+{
+  CHBuilder<Queue> b;
+  CHGraph *ch;
+  CHArcList *upArcs[2];
+  CHArcList::const_iterator arc;
+  std::vector<long> remaining, round, left;
+  std::vector<CHShortcut> *shortcuts;
+  long n = graph->n, v, a, i, j, nextRank = 0, cArcs;
+  int dir, t;
+  bool best;
+
+  if (threads < 1)
+    threads = 1;
+  b.n = n;
+  for (dir = 0; dir < 2; dir++) {
+    b.adj[dir] = new CHArcList[n];
+    upArcs[dir] = new CHArcList[n];
+  }
+  b.contracted = new bool[n];
+  b.inRound = new bool[n];
+  b.dirty = new bool[n];
+  b.deleted = new long[n];
+  b.priority = new long long[n];
+  b.witness = new CHWitness<Queue>[threads];
+  for (t = 0; t < threads; t++)
+    chWitnessInit(b.witness + t, graph);
+  pthread_mutex_init(&b.lock, NULL);
+
+  ch = (CHGraph *) malloc(sizeof(CHGraph));
+  ch->n = n;
+  ch->rank = (long *) malloc(n * sizeof(long));
+  if (ch->rank == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the hierarchy\n");
+    exit(1);
+  }
+
+  // the graph without loops and parallel arcs
+  for (v = 0; v < n; v++) {
+    for (a = graph->first[v]; a < graph->first[v + 1]; a++)
+      if (csr_head(graph, a) != v)
+	chAddArc(b.adj, v, csr_head(graph, a), csr_len(graph, a), -1);
+  }
+
+  for (v = 0; v < n; v++) {
+    b.contracted[v] = b.inRound[v] = false;
+    b.dirty[v] = true;
+    b.deleted[v] = 0;
+    remaining.push_back(v);
+  }
+
+  for (;;) {
+    cArcs = 0;
+    for (i = 0; i < (long) remaining.size(); i++)
+      cArcs += (long) b.adj[0][remaining[i]].size();
+    if (remaining.empty() || cArcs > CH_CORE_DEGREE * (long) remaining.size())
+      break;
+
+    // lazy priority updates
+    round.clear();
+    for (i = 0; i < (long) remaining.size(); i++)
+      if (b.dirty[remaining[i]])
+	round.push_back(remaining[i]);
+    b.work = &round;
+    b.shortcuts = NULL;
+    chParallel(&b, threads);
+
+    // nodes that go before all their neighbors
+    round.clear();
+    left.clear();
+    for (i = 0; i < (long) remaining.size(); i++) {
+      v = remaining[i];
+      best = true;
+      for (dir = 0; dir < 2 && best; dir++)
+	for (arc = b.adj[dir][v].begin(); arc != b.adj[dir][v].end(); ++arc)
+	  if (!chBefore(&b, v, arc->other)) {
+	    best = false;
+	    break;
+	  }
+      if (best) {
+	round.push_back(v);
+	b.inRound[v] = true;
+      }
+      else
+	left.push_back(v);
+    }
+
+    shortcuts = new std::vector<CHShortcut>[round.size()];
+    b.work = &round;
+    b.shortcuts = shortcuts;
+    chParallel(&b, threads);
+
+    for (i = 0; i < (long) round.size(); i++) {
+      v = round[i];
+      ch->rank[v] = nextRank++;
+      for (dir = 0; dir < 2; dir++) {
+	upArcs[dir][v] = b.adj[dir][v];
+	for (arc = b.adj[dir][v].begin(); arc != b.adj[dir][v].end(); ++arc) {
+	  chRemoveArc(&b.adj[1 - dir][arc->other], v);
+	  b.deleted[arc->other]++;
+	  b.dirty[arc->other] = true;
+	}
+	CHArcList().swap(b.adj[dir][v]);
+      }
+      for (j = 0; j < (long) shortcuts[i].size(); j++)
+	chAddArc(b.adj, shortcuts[i][j].tail, shortcuts[i][j].head,
+		 shortcuts[i][j].len, v);
+      b.contracted[v] = true;
+      b.inRound[v] = false;
+    }
+    delete [] shortcuts;
+    remaining.swap(left);
+  }
+
+  // the core, if any
+  for (i = 0; i < (long) remaining.size(); i++) {
+    v = remaining[i];
+    ch->rank[v] = nextRank++;
+    for (dir = 0; dir < 2; dir++)
+      upArcs[dir][v] = b.adj[dir][v];
+  }
+
+  for (dir = 0; dir < 2; dir++) {
+    ch->up[dir] = chMakeUp(n, upArcs[dir]);
+    delete [] upArcs[dir];
+    delete [] b.adj[dir];
+  }
+  pthread_mutex_destroy(&b.lock);
+  for (t = 0; t < threads; t++)
+    chWitnessFree(b.witness + t);
+  delete [] b.witness;
+  delete [] b.contracted;
+  delete [] b.inRound;
+  delete [] b.dirty;
+  delete [] b.deleted;
+  delete [] b.priority;
+  return ch;
+}
+
+//-------------------------------------------------------------
+// chWrite()
+// chRead()
+// chFree()
+//-------------------------------------------------------------
+
+static void chWriteLongs(FILE *file, long *a, long count)
+{
+  long long x;
+  long i;
+
+  for (i = 0; i < count; i++) {
+    x = a[i];
+    fwrite(&x, sizeof(long long), 1, file);
+  }
+}
+
+void chWrite(CHGraph *ch, CSRGraph *graph, const char *fileName)
+{
+  FILE *file = fopen(fileName, "wb");
+  int version = CH_VERSION, dir;
+  unsigned long long hash = csr_hash(graph);
+  long long x[3];
+  long i;
+
+  if (file == NULL) {
+    fprintf(stderr, "ERROR: can't open hierarchy file %s\n", fileName);
+    exit(1);
+  }
+  fwrite("CH\0", 1, 4, file);
+  fwrite(&version, sizeof(int), 1, file);
+  fwrite(&graph->order, sizeof(int), 1, file);
+  fwrite(&hash, sizeof(unsigned long long), 1, file);
+  x[0] = ch->n;
+  x[1] = ch->up[0].m;
+  x[2] = ch->up[1].m;
+  fwrite(x, sizeof(long long), 3, file);
+  chWriteLongs(file, ch->rank, ch->n);
+  for (dir = 0; dir < 2; dir++) {
+    chWriteLongs(file, ch->up[dir].first, ch->n + 1);
+    for (i = 0; i < ch->up[dir].m; i++) {
+      x[0] = ch->up[dir].arcs[i].len;
+      x[1] = ch->up[dir].arcs[i].head;
+      x[2] = ch->up[dir].arcs[i].mid;
+      fwrite(x, sizeof(long long), 3, file);
+    }
+  }
+  if (ferror(file) || fclose(file) != 0) {
+    fprintf(stderr, "ERROR: can't write hierarchy file %s\n", fileName);
+    exit(1);
+  }
+}
+
+static void chReadError(const char *fileName, const char *message)
+{
+  fprintf(stderr, "ERROR: hierarchy file %s: %s\n", fileName, message);
+  exit(1);
+}
+
+static void chReadLongs(FILE *file, const char *fileName, long *a, long count,
+			long max)
+{
+  long long x;
+  long i;
+
+  for (i = 0; i < count; i++) {
+    if (fread(&x, sizeof(long long), 1, file) != 1)
+      chReadError(fileName, "file is truncated");
+    if (x < 0 || x > max)
+      chReadError(fileName, "bad value");
+    a[i] = (long) x;
+  }
+}
+
+CHGraph *chRead(const char *fileName, CSRGraph *graph)
+{
+  FILE *file = fopen(fileName, "rb");
+  CHGraph *ch;
+  char magic[4];
+  int version, dir, order;
+  unsigned long long hash;
+  long long x[3];
+  long i, n = graph->n;
+
+  if (file == NULL) {
+    fprintf(stderr, "ERROR: can't open hierarchy file %s\n", fileName);
+    exit(1);
+  }
+  if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "CH\0", 4) != 0 ||
+      fread(&version, sizeof(int), 1, file) != 1 ||
+      fread(&order, sizeof(int), 1, file) != 1 ||
+      fread(&hash, sizeof(unsigned long long), 1, file) != 1 ||
+      fread(x, sizeof(long long), 3, file) != 3)
+    chReadError(fileName, "not a hierarchy file");
+  if (version != CH_VERSION)
+    chReadError(fileName, "unsupported version");
+  if (x[0] != n)
+    chReadError(fileName, "number of nodes differs from the graph");
+  csr_check_stamp(graph, order, hash, "hierarchy file", fileName);
+  if (x[1] < 0 || x[2] < 0)
+    chReadError(fileName, "bad number of arcs");
+
+  ch = (CHGraph *) malloc(sizeof(CHGraph));
+  ch->n = n;
+  ch->up[0].m = (long) x[1];
+  ch->up[1].m = (long) x[2];
+  ch->rank = (long *) malloc(n * sizeof(long));
+  for (dir = 0; dir < 2; dir++) {
+    ch->up[dir].first = (long *) malloc((n + 1) * sizeof(long));
+    ch->up[dir].arcs = (CHArc *) malloc((ch->up[dir].m + 1) * sizeof(CHArc));
+    if (ch->up[dir].first == NULL || ch->up[dir].arcs == NULL) {
+      fprintf(stderr, "ERROR: can't allocate the hierarchy\n");
+      exit(1);
+    }
+  }
+  if (ch->rank == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the hierarchy\n");
+    exit(1);
+  }
+
+  chReadLongs(file, fileName, ch->rank, n, n - 1);
+  for (dir = 0; dir < 2; dir++) {
+    chReadLongs(file, fileName, ch->up[dir].first, n + 1, ch->up[dir].m);
+    for (i = 0; i < ch->up[dir].m; i++) {
+      if (fread(x, sizeof(long long), 3, file) != 3)
+	chReadError(fileName, "file is truncated");
+      if (x[0] < 0 || x[1] < 0 || x[1] >= n || x[2] < -1 || x[2] >= n)
+	chReadError(fileName, "bad arc");
+      ch->up[dir].arcs[i].len = x[0];
+      ch->up[dir].arcs[i].head = (long) x[1];
+      ch->up[dir].arcs[i].mid = (long) x[2];
+    }
+  }
+  fclose(file);
+  return ch;
+}
+
+void chFree(CHGraph *ch)
+{
+  int dir;
+
+  for (dir = 0; dir < 2; dir++) {
+    free(ch->up[dir].first);
+    free(ch->up[dir].arcs);
+  }
+  free(ch->rank);
+  free(ch);
+}
+
+// the witness queues the engine registry (engine.cc) builds with
+template CHGraph *chBuild<FiboHeap_Wrapper<long long> >(CSRGraph *, int);
+template CHGraph *chBuild<BinoHeap_Wrapper<long long> >(CSRGraph *, int);
+template CHGraph *chBuild<RadixHeap_Wrapper<long long> >(CSRGraph *, int);
+template CHGraph *chBuild<Dary2Heap_Wrapper<long long> >(CSRGraph *, int);
+template CHGraph *chBuild<Dary4Heap_Wrapper<long long> >(CSRGraph *, int);
+template CHGraph *chBuild<Dary8Heap_Wrapper<long long> >(CSRGraph *, int);
+template CHGraph *chBuild<PairHeap_Wrapper<long long> >(CSRGraph *, int);
@@ -0,0 +1,311 @@
+// ch.h
+//     Contraction Hierarchies.  Preprocessing (ch.cc) removes nodes
+//     one at a time in order of importance and adds a shortcut u->w
+//     of length len(u,v) + len(v,w) whenever contracting v would
+//     otherwise lose the shortest u-w path.  The result is, for each
+//     node, the arcs to nodes contracted later ("upward"), kept as
+//     two CSR arrays:
+//
+//       up[0]  arcs v->w with rank[w] > rank[v], listed at v
+//       up[1]  arcs w->v with rank[w] > rank[v], listed at v with
+//              head holding w
+//
+//     (but see the core, below).
+//
+//     A shortcut records the node it bypasses (mid), so a path in
+//     the hierarchy can be unpacked into graph arcs.
+//
+//     Contraction stops early once the remaining graph averages more
+//     than CH_CORE_DEGREE arcs per node, as it does on graphs with no
+//     small separators: each shortcut then saves little and costs a
+//     lot of witness searches.  The nodes left (the core) get the top
+//     ranks and keep all their arcs in both arrays, so the query
+//     simply runs bidirectional Dijkstra within the core.
+//
+//     A query is a bidirectional Dijkstra that only goes up: forward
+//     from the source over up[0], backward from the sink over up[1].
+//     A direction stops once its queue minimum reaches mu, the best
+//     meeting distance so far.  The path found is unpacked into the
+//     labels and parents of SP, so as in every other mode the
+//     parents from sink lead back to the source.
+//
+//     The hierarchy file holds, in host byte order, with I = long long
+//     and U = unsigned long long:
+//
+//       char magic[4]          "CH\0\0"
+//       int  version           CH_VERSION
+//       int  order             graph->order, and
+//       U    hash              csr_hash() of the graph
+//       I    n, m0, m1
+//       I    rank[n]
+//       I    first0[n+1], arcs0[m0][3], first1[n+1], arcs1[m1][3]
+//
+//     where an arc is (len, head, mid) and mid is -1 for graph arcs.
+
+#ifndef CH_H
+#define CH_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include "sp.h"
+
+#define CH_VERSION          2
+
+#define CH_HOP_LIMIT        5          // witness searches: at most this
+#define CH_SETTLE_LIMIT     500        // many arcs, and settled nodes
+#define CH_SIM_SETTLE_LIMIT 50         // settled nodes, for priorities
+#define CH_CORE_DEGREE      16         // stop contracting past this
+
+typedef struct CHArc {
+  long long len;
+  long head;
+  long mid;              // node a shortcut bypasses, or -1
+} CHArc;
+
+typedef struct CHUp {
+  long m;
+  long *first;           // n+1 offsets into arcs
+  CHArc *arcs;
+} CHUp;
+
+typedef struct CHGraph {
+  long n;
+  long *rank;            // contraction order
+  CHUp up[2];
+} CHGraph;
+
+// builds the hierarchy with threads threads; Queue is the heap
+// wrapper (with 64-bit keys) used by the witness searches
+template <class Queue>
+CHGraph *chBuild(CSRGraph *graph, int threads);
+// graph is the one the hierarchy was built from
+CHGraph *chRead(const char *fileName, CSRGraph *graph);
+void chWrite(CHGraph *ch, CSRGraph *graph, const char *fileName);
+void chFree(CHGraph *ch);
+
+template <class Queue>
+class CHEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   CHGraph *ch;
+   bool owner;                // frees ch; false for clones
+   Queue *queue[2];           // 0: forward, 1: backward
+   Node *rnodes;              // backward labels
+   long *rparent;             // and parents
+   std::vector<long> path;    // unpacked source-sink path
+
+   const CHArc *FindArc(int dir, long v, long head);
+   void Unpack(long tail, long head, long long len, long mid);
+   void SetPath(Node *source, Node *meet, Node *nodes, SP *sp);
+ public:
+   CHEngine(CSRGraph *graphGiven, CHGraph *chGiven);
+   ~CHEngine();
+   SPEngine *Clone(Node *nodes);
+   bool run(Node *source, Node *sink, SP *sp);
+};
+
+template <class Queue>
+CHEngine<Queue>::CHEngine(CSRGraph *graphGiven, CHGraph *chGiven)
+{
+  graph = graphGiven;
+  ch = chGiven;
+  owner = true;
+  queue[0] = new Queue(graph);    // (the queues only look at graph->n)
+  queue[1] = new Queue(graph);
+  rnodes = (Node *) calloc(ch->n, sizeof(Node));
+  if (rnodes == NULL) {
+    fprintf(stderr, "ERROR: can't allocate backward labels\n");
+    exit(1);
+  }
+  rparent = new long[ch->n > 0 ? ch->n : 1];
+}
+
+template <class Queue>
+CHEngine<Queue>::~CHEngine()
+{
+  delete queue[0];
+  delete queue[1];
+  free(rnodes);
+  delete [] rparent;
+  if (owner)
+    chFree(ch);
+}
+
+template <class Queue>
+SPEngine *CHEngine<Queue>::Clone(Node *)
+{
+  CHEngine<Queue> *clone = new CHEngine<Queue>(graph, ch);
+
+  clone->owner = false;
+  return clone;
+}
+
+// the arc of up[dir] at v whose other end is head
+template <class Queue>
+const CHArc *CHEngine<Queue>::FindArc(int dir, long v, long head)
+{
+  const CHArc *arc, *lastArc = ch->up[dir].arcs + ch->up[dir].first[v + 1];
+
+  for (arc = ch->up[dir].arcs + ch->up[dir].first[v]; arc < lastArc; arc++)
+    if (arc->head == head)
+      return arc;
+  fprintf(stderr, "ERROR: broken hierarchy: no arc %ld-%ld\n", v, head);
+  exit(1);
+}
+
+//-------------------------------------------------------------
+// CHEngine::Unpack()
+//     Appends the graph arcs of the hierarchy arc tail->head to
+//     path, as (node, length of the arc into it) pairs.  A shortcut
+//     bypassing mid is tail->mid, which mid keeps in up[1], followed
+//     by mid->head, kept in up[0].
+//-------------------------------------------------------------
+
+template <class Queue>
+void CHEngine<Queue>::Unpack(long tail, long head, long long len, long mid)
+{
+  const CHArc *arc;
+
+  if (mid < 0) {
+    path.push_back(head);
+    path.push_back((long) len);
+    return;
+  }
+  arc = FindArc(1, mid, tail);
+  Unpack(tail, mid, arc->len, arc->mid);
+  arc = FindArc(0, mid, head);
+  Unpack(mid, head, arc->len, arc->mid);
+}
+
+//-------------------------------------------------------------
+// CHEngine::SetPath()
+//     Unpacks source .. meet (forward labels) and meet .. sink
+//     (backward labels) and writes the path into the forward
+//     labels: each node gets its parent on the path and its
+//     distance from the source.
+//-------------------------------------------------------------
+
+template <class Queue>
+void CHEngine<Queue>::SetPath(Node *source, Node *meet, Node *nodes, SP *sp)
+{
+  std::vector<long> hops;     // hierarchy nodes source .. sink
+  const CHArc *arc;
+  long *parent = sp->getParents();
+  Node *v;
+  long i, tail, u;
+  long long dist;
+
+  for (u = meet - nodes; u != source - nodes; u = parent[u])
+    hops.push_back(u);
+  hops.push_back(source - nodes);
+  for (i = 0; i < (long) hops.size() / 2; i++) {
+    tail = hops[i];
+    hops[i] = hops[hops.size() - 1 - i];
+    hops[hops.size() - 1 - i] = tail;
+  }
+  for (u = meet - nodes; rparent[u] != u; u = rparent[u])
+    hops.push_back(rparent[u]);
+
+  path.clear();
+  for (i = 0; i + 1 < (long) hops.size(); i++) {
+    // an upward forward arc is kept at its tail, a backward one at
+    // its head
+    if (ch->rank[hops[i]] < ch->rank[hops[i + 1]])
+      arc = FindArc(0, hops[i], hops[i + 1]);
+    else
+      arc = FindArc(1, hops[i + 1], hops[i]);
+    Unpack(hops[i], hops[i + 1], arc->len, arc->mid);
+  }
+
+  dist = 0;
+  u = source - nodes;
+  for (i = 0; i < (long) path.size(); i += 2) {
+    v = nodes + path[i];
+    if (v->tStamp != sp->curTime)
+      sp->initNode(v);
+    dist += path[i + 1];
+    v->dist = dist;
+    parent[path[i]] = u;
+    u = path[i];
+  }
+}
+
+template <class Queue>
+bool CHEngine<Queue>::run(Node *source, Node *sink, SP *sp)
+{
+  Node *nodes = sp->getNodes(), *label[2], *u, *w, *meet = NULL;
+  long *parent[2];
+  const CHArc *arc, *lastArc;
+  long long mu = VERY_FAR, newDist;
+  bool active[2];
+  int dir = 1, side;
+  long v;
+
+  sp->curTime++;
+  source->tStamp = sp->curTime;     // initS has set dist and parent
+  if (source == sink)
+    return true;
+
+  label[0] = nodes;
+  label[1] = rnodes;
+  parent[0] = sp->getParents();
+  parent[1] = rparent;
+  u = rnodes + (sink - nodes);
+  sp->initNode(u);
+  u->dist = 0;
+  rparent[sink - nodes] = sink - nodes;
+
+  queue[0]->Clear();
+  queue[1]->Clear();
+  queue[0]->Push(source - nodes, 0);
+  source->where = IN_HEAP;
+  queue[1]->Push(sink - nodes, 0);
+  u->where = IN_HEAP;
+
+  for (;;) {
+    for (side = 0; side < 2; side++)
+      active[side] = !queue[side]->IsEmpty() && queue[side]->MinKey() < mu;
+    if (!active[0] && !active[1])
+      break;
+    // alternate while both directions are still going
+    dir = active[1 - dir] ? 1 - dir : dir;
+
+    v = queue[dir]->PopMin();
+    u = label[dir] + v;
+    u->where = IN_SCANNED;
+    sp->cScans++;
+
+    lastArc = ch->up[dir].arcs + ch->up[dir].first[v + 1];
+    for (arc = ch->up[dir].arcs + ch->up[dir].first[v]; arc < lastArc; arc++) {
+      w = label[dir] + arc->head;
+      if (w->tStamp != sp->curTime)
+	sp->initNode(w);
+      newDist = u->dist + arc->len;
+      if (newDist < w->dist) {
+	w->dist = newDist;
+	parent[dir][arc->head] = v;
+	if (w->where == IN_HEAP)
+	  queue[dir]->Decrease(arc->head, newDist);
+	else {
+	  queue[dir]->Push(arc->head, newDist);
+	  w->where = IN_HEAP;
+	}
+	sp->cUpdates++;
+
+	if (label[1 - dir][arc->head].tStamp == sp->curTime &&
+	    newDist + label[1 - dir][arc->head].dist < mu) {
+	  mu = newDist + label[1 - dir][arc->head].dist;
+	  meet = nodes + arc->head;
+	}
+      }
+    }
+  }
+
+  if (meet == NULL)
+    return false;
+  SetPath(source, meet, nodes, sp);
+  return true;
+}
+
+#endif
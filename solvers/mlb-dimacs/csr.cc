@@ -0,0 +1,275 @@
+// csr.cc
+//     Builds the compressed-sparse-row graph from arc arrays, and its
+//     reverse for backward searches; parse_gr fills one in itself.
+//     Code here reads arcs through csr_head() and csr_len(), so it
+//     works on either layout.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include "csr.h"
+#include "reorder.h"
+
+CSRGraph *csr_alloc(long n, long m, bool compact /* = false */)
+{
+  CSRGraph *graph;
+
+  graph = (CSRGraph *) malloc(sizeof(CSRGraph));
+  if (graph == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+    exit(1);
+  }
+  graph->n = n;
+  graph->m = m;
+  graph->reverse = NULL;
+  graph->x = graph->y = NULL;
+  graph->lonLat = false;
+  graph->order = 0;
+  graph->caliber = NULL;
+  graph->arcs32 = NULL;
+  graph->map = NULL;
+  graph->mapSize = 0;
+  graph->first = (long *) malloc((n + 1) * sizeof(long));
+  graph->arcs = NULL;
+  if (compact)
+    graph->arcs32 = (CSRArc32 *) malloc((m + 1) * sizeof(CSRArc32));
+  else
+    graph->arcs = (CSRArc *) malloc((m + 1) * sizeof(CSRArc));
+  if (graph->first == NULL ||
+      (graph->arcs == NULL && graph->arcs32 == NULL)) {
+    fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+    exit(1);
+  }
+  return graph;
+}
+
+// counting sort of the arcs by tail
+CSRGraph *csr_build_arcs(long n, long m, const long *tails,
+			 const long *heads, const long long *lens)
+{
+  CSRGraph *graph = csr_alloc(n, m);
+  long v, i, *pos;
+
+  for (v = 0; v <= n; v++)
+    graph->first[v] = 0;
+  for (i = 0; i < m; i++)
+    graph->first[tails[i] + 1]++;
+  for (v = 0; v < n; v++)
+    graph->first[v + 1] += graph->first[v];
+
+  pos = (long *) malloc((n + 1) * sizeof(long));
+  if (pos == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+    exit(1);
+  }
+  for (v = 0; v <= n; v++)
+    pos[v] = graph->first[v];
+  for (i = 0; i < m; i++) {
+    graph->arcs[pos[tails[i]]].len = lens[i];
+    graph->arcs[pos[tails[i]]].head = heads[i];
+    pos[tails[i]]++;
+  }
+
+  free(pos);
+  return graph;
+}
+
+// counting sort of the arcs by head; within a head, arcs keep the
+// order of their tails
+void csr_add_reverse(CSRGraph *graph)
+{
+  CSRGraph *rev;
+  long v, a, w, *pos;
+
+  if (graph->reverse != NULL)
+    return;
+  rev = csr_alloc(graph->n, graph->m, graph->arcs32 != NULL);
+
+  for (v = 0; v <= graph->n; v++)
+    rev->first[v] = 0;
+  for (a = 0; a < graph->m; a++)
+    rev->first[csr_head(graph, a) + 1]++;
+  for (v = 0; v < graph->n; v++)
+    rev->first[v + 1] += rev->first[v];
+
+  pos = (long *) malloc((graph->n + 1) * sizeof(long));
+  if (pos == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+    exit(1);
+  }
+  for (v = 0; v <= graph->n; v++)
+    pos[v] = rev->first[v];
+
+  for (v = 0; v < graph->n; v++)
+    for (a = graph->first[v]; a < graph->first[v + 1]; a++) {
+      w = csr_head(graph, a);
+      if (rev->arcs32 != NULL) {
+	rev->arcs32[pos[w]].len = graph->arcs32[a].len;
+	rev->arcs32[pos[w]].head = (unsigned int) v;
+      }
+      else {
+	rev->arcs[pos[w]].len = graph->arcs[a].len;
+	rev->arcs[pos[w]].head = v;
+      }
+      pos[w]++;
+    }
+
+  free(pos);
+  graph->reverse = rev;
+}
+
+bool csr_fits_compact(CSRGraph *graph)
+{
+  long a;
+  long long len;
+
+  if (graph->arcs32 != NULL)
+    return true;
+  if (graph->n > CSR_COMPACT_MAX)
+    return false;
+  for (a = 0; a < graph->m; a++) {
+    len = graph->arcs[a].len;
+    if (len < 0 || len > CSR_COMPACT_MAX)
+      return false;
+  }
+  return true;
+}
+
+// arrays of a mapped graph may lie in the file
+static void csr_release(CSRGraph *graph, void *a)
+{
+  char *map = (char *) graph->map;
+
+  if (map == NULL || (char *) a < map || (char *) a >= map + graph->mapSize)
+    free(a);
+}
+
+bool csr_compact(CSRGraph *graph)
+{
+  CSRArc32 *arcs32;
+  long a;
+
+  if (graph->arcs32 == NULL && graph->map == NULL &&
+      csr_fits_compact(graph)) {
+    arcs32 = (CSRArc32 *) malloc((graph->m + 1) * sizeof(CSRArc32));
+    if (arcs32 == NULL) {
+      fprintf(stderr, "ERROR: can't allocate the compact arcs\n");
+      exit(1);
+    }
+    for (a = 0; a < graph->m; a++) {
+      arcs32[a].len = (unsigned int) graph->arcs[a].len;
+      arcs32[a].head = (unsigned int) graph->arcs[a].head;
+    }
+    csr_release(graph, graph->arcs);
+    graph->arcs = NULL;
+    graph->arcs32 = arcs32;
+  }
+  if (graph->arcs32 != NULL && graph->reverse != NULL)
+    csr_compact(graph->reverse);    // same lengths, so it fits too
+  return graph->arcs32 != NULL;
+}
+
+void csr_widen(CSRGraph *graph)
+{
+  CSRArc *arcs;
+  long a;
+
+  if (graph->arcs32 != NULL) {
+    arcs = (CSRArc *) malloc((graph->m + 1) * sizeof(CSRArc));
+    if (arcs == NULL) {
+      fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+      exit(1);
+    }
+    for (a = 0; a < graph->m; a++) {
+      arcs[a].len = graph->arcs32[a].len;
+      arcs[a].head = graph->arcs32[a].head;
+    }
+    csr_release(graph, graph->arcs32);
+    graph->arcs32 = NULL;
+    graph->arcs = arcs;
+  }
+  if (graph->reverse != NULL)
+    csr_widen(graph->reverse);
+}
+
+// a node with no arc in is never reached but as a source, so its
+// caliber is never read; it is left at 0
+void csr_add_calibers(CSRGraph *graph)
+{
+  long long *caliber, len;
+  long v, a, w;
+
+  if (graph->caliber != NULL)
+    return;
+  caliber = (long long *) malloc((graph->n + 1) * sizeof(long long));
+  if (caliber == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the calibers\n");
+    exit(1);
+  }
+  for (v = 0; v < graph->n; v++)
+    caliber[v] = -1;
+  for (a = 0; a < graph->m; a++) {
+    w = csr_head(graph, a);
+    len = csr_len(graph, a);
+    if (caliber[w] < 0 || caliber[w] > len)
+      caliber[w] = len;
+  }
+  for (v = 0; v < graph->n; v++)
+    if (caliber[v] < 0)
+      caliber[v] = 0;
+  graph->caliber = caliber;
+}
+
+void csr_free(CSRGraph *graph)
+{
+  if (graph->reverse != NULL)
+    csr_free(graph->reverse);
+  csr_release(graph, graph->x);
+  csr_release(graph, graph->y);
+  free(graph->caliber);
+  csr_release(graph, graph->first);
+  csr_release(graph, graph->arcs);
+  csr_release(graph, graph->arcs32);
+  if (graph->map != NULL)
+    munmap(graph->map, graph->mapSize);
+  free(graph);
+}
+
+// FNV-1a, a word at a time
+static inline unsigned long long csrHashWord(unsigned long long h,
+					     unsigned long long x)
+{
+  return (h ^ x) * 1099511628211ULL;
+}
+
+unsigned long long csr_hash(CSRGraph *graph)
+{
+  unsigned long long h = 14695981039346656037ULL;
+  long v, a;
+
+  h = csrHashWord(h, graph->n);
+  h = csrHashWord(h, graph->m);
+  for (v = 0; v <= graph->n; v++)
+    h = csrHashWord(h, graph->first[v]);
+  for (a = 0; a < graph->m; a++) {
+    h = csrHashWord(h, csr_head(graph, a));
+    h = csrHashWord(h, csr_len(graph, a));
+  }
+  return h;
+}
+
+void csr_check_stamp(CSRGraph *graph, int order, unsigned long long hash,
+		     const char *what, const char *fileName)
+{
+  if (order != graph->order) {
+    fprintf(stderr, "ERROR: %s %s: made with node order %s, not %s (--reorder)\n",
+	    what, fileName, reorderMethodName(order),
+	    reorderMethodName(graph->order));
+    exit(1);
+  }
+  if (hash != csr_hash(graph)) {
+    fprintf(stderr, "ERROR: %s %s: made for a different graph\n",
+	    what, fileName);
+    exit(1);
+  }
+}
@@ -0,0 +1,141 @@
+/* csr.h
+ *     Compressed-sparse-row form of the graph.  It is built once,
+ *     by parse_gr or from arc arrays, and then shared, read-only, by
+ *     every queue backend.  The arcs out of node v are
+ *     arcs[first[v]] .. arcs[first[v+1]-1]; first[n] == m is the
+ *     sentinel.  Nodes are referred to by their index 0 .. n-1, the
+ *     same index they have in the label (Node) arrays.  The arcs are
+ *     held in one of two layouts, arcs or arcs32 (below), the other
+ *     being NULL.
+ *
+ *     A graph can also be saved in a binary file (csrbin.cc) that is
+ *     later mapped into memory instead of parsed.  The file holds, in
+ *     host byte order, with I = long long and U = unsigned int:
+ *
+ *       char magic[4]          "GR\0\0"
+ *       int  version           CSR_BIN_VERSION
+ *       I    n, m, coords      coords is 1 if x and y follow
+ *       I    compact           1 if the arcs are in the compact layout
+ *       I    first[n+1]
+ *       I    arcs[m][2]        (len, head), or if compact
+ *       U    arcs[m][2]        (len, head)
+ *       I    x[n], y[n]        if coords
+ *
+ *     Where long is 64 bits the arrays are the CSRGraph arrays
+ *     themselves, so a mapped graph points into the file: nothing is
+ *     copied, and processes reading the same file share its pages.
+ */
+
+#ifndef CSR_H
+#define CSR_H
+
+#include <stddef.h>
+
+#define CSR_BIN_VERSION     2
+
+typedef struct CSRArc {
+  long long len;         // arc length
+  long head;             // index of the node the arc ends at
+} CSRArc;
+
+// The same arcs in half the space, for graphs whose node indices
+// and arc lengths all fit in 32 bits (csr_compact).  Search loops
+// are templates on the arc type and scan whichever layout the graph
+// has; other code reads arcs through csr_head() and csr_len().
+typedef struct CSRArc32 {
+  unsigned int len;
+  unsigned int head;
+} CSRArc32;
+
+#define CSR_COMPACT_MAX     4294967295LL   // largest index or length
+
+// The node id kept in a heap entry (radixheap.h, daryheap.h).  int
+// keys are only chosen when every distance fits in 31 bits, so the
+// graph has fewer than 2^32 nodes and a 32-bit id makes the entry 8
+// bytes instead of 16; the heaps check n when they are built.
+template <class KeyType>
+struct HeapNodeId { typedef long type; };
+
+template <>
+struct HeapNodeId<int> { typedef unsigned int type; };
+
+typedef struct CSRGraph {
+  long n;                // number of nodes
+  long m;                // number of arcs
+  long *first;           // n+1 offsets into arcs
+  CSRArc *arcs;          // arcs grouped by tail, or NULL if compact
+  struct CSRGraph *reverse;  // same arcs grouped by head, with head
+                             // holding the tail; NULL unless built by
+                             // csr_add_reverse()
+  long *x, *y;           // node coordinates from a .co file (parse_co)
+                         // or a binary graph file, or NULL; freed with
+                         // the graph
+  bool lonLat;           // x, y are longitude and latitude in millionths
+                         // of a degree rather than points in the plane
+  long long *caliber;    // caliber[v] is the length of the shortest arc
+                         // into v; NULL unless built by
+                         // csr_add_calibers()
+  CSRArc32 *arcs32;      // the arcs in the compact layout instead, or
+                         // NULL (csr_compact())
+  int order;             // node order (reorder.h) the graph is numbered
+                         // in, 0 for that of the input
+  void *map;             // the binary file the arrays may point into
+  size_t mapSize;        // (csr_map_bin), or NULL
+} CSRGraph;
+
+// a graph of n nodes and m arcs whose first and arcs (or arcs32, if
+// compact) arrays are allocated but not set (for parse_gr)
+CSRGraph *csr_alloc(long n, long m, bool compact = false);
+// builds the CSR graph from m arcs tails[i] -> heads[i] of length
+// lens[i], nodes numbered 0 .. n-1; arcs of a tail keep their order
+CSRGraph *csr_build_arcs(long n, long m, const long *tails,
+			 const long *heads, const long long *lens);
+// builds graph->reverse (for searches that run backward from a sink),
+// in the layout of the graph
+void csr_add_reverse(CSRGraph *graph);
+// whether all heads and lengths fit the compact layout
+bool csr_fits_compact(CSRGraph *graph);
+// moves the arcs, and those of the reverse graph if there is one, to
+// the compact layout if all heads and lengths fit, freeing the wide
+// ones; returns whether the graph is compact.  A mapped graph keeps
+// the layout of its file (csr_write_bin picks the compact one
+// whenever it fits), so its pages stay shared.
+bool csr_compact(CSRGraph *graph);
+// moves the arcs, and those of the reverse graph, back to the wide
+// layout (a private copy, for a mapped graph)
+void csr_widen(CSRGraph *graph);
+// builds graph->caliber (for queues that settle a node early when
+// its distance is within its caliber of the queue minimum)
+void csr_add_calibers(CSRGraph *graph);
+void csr_free(CSRGraph *graph);      // frees the reverse graph too
+
+// head and length of arc a, in either layout
+static inline long csr_head(const CSRGraph *graph, long a)
+{
+  return graph->arcs32 ? (long) graph->arcs32[a].head : graph->arcs[a].head;
+}
+
+static inline long long csr_len(const CSRGraph *graph, long a)
+{
+  return graph->arcs32 ? (long long) graph->arcs32[a].len : graph->arcs[a].len;
+}
+
+// a hash of n, m, first and the arcs, which tells the graph in one
+// node numbering from any other.  Files of data computed from the
+// graph (landmarks, hierarchy, arc flags) store it and graph->order,
+// and csr_check_stamp() rejects them for a graph they don't match;
+// what and fileName are for the message.
+unsigned long long csr_hash(CSRGraph *graph);
+void csr_check_stamp(CSRGraph *graph, int order, unsigned long long hash,
+		     const char *what, const char *fileName);
+
+// whether fileName starts like a binary graph file
+bool csr_is_bin(const char *fileName);
+// saves the graph, and its coordinates if any, in a binary file, with
+// the arcs in the compact layout if they fit
+void csr_write_bin(CSRGraph *graph, const char *fileName);
+// maps a binary graph file; the graph keeps the file mapped until
+// csr_free().  Its coordinates, if any, become graph->x and y.
+CSRGraph *csr_map_bin(const char *fileName);
+
+#endif
@@ -0,0 +1,212 @@
+// csrbin.cc
+//     Binary graph files (format in csr.h): written once from a
+//     parsed graph, then mapped read-only by every run.  A mapped
+//     file is checked as thoroughly as parse_gr checks its input,
+//     which reads it once; the page cache makes that cheap for all
+//     but the first process.
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "csr.h"
+
+#define CSR_BIN_HEADER      40         // magic, version, n, m, coords,
+                                       // compact
+
+static void csrBinError(const char *fileName, const char *message)
+{
+  fprintf(stderr, "ERROR: graph file %s: %s\n", fileName, message);
+  exit(1);
+}
+
+bool csr_is_bin(const char *fileName)
+{
+  FILE *file = fopen(fileName, "rb");
+  char magic[4];
+  bool bin;
+
+  if (file == NULL)
+    return false;
+  bin = (fread(magic, 1, 4, file) == 4 && memcmp(magic, "GR\0", 4) == 0);
+  fclose(file);
+  return bin;
+}
+
+static void csrWriteLongs(FILE *file, const long *a, long count)
+{
+  long long x;
+  long i;
+
+  for (i = 0; i < count; i++) {
+    x = a[i];
+    fwrite(&x, sizeof(long long), 1, file);
+  }
+}
+
+void csr_write_bin(CSRGraph *graph, const char *fileName)
+{
+  FILE *file = fopen(fileName, "wb");
+  int version = CSR_BIN_VERSION;
+  bool compact = csr_fits_compact(graph);
+  unsigned int u[2];
+  long long x[4];
+  long i;
+
+  if (file == NULL) {
+    fprintf(stderr, "ERROR: can't open graph file %s\n", fileName);
+    exit(1);
+  }
+  fwrite("GR\0", 1, 4, file);
+  fwrite(&version, sizeof(int), 1, file);
+  x[0] = graph->n;
+  x[1] = graph->m;
+  x[2] = (graph->x != NULL && graph->y != NULL);
+  x[3] = compact;
+  fwrite(x, sizeof(long long), 4, file);
+  csrWriteLongs(file, graph->first, graph->n + 1);
+  for (i = 0; i < graph->m; i++)
+    if (compact) {
+      u[0] = (unsigned int) csr_len(graph, i);
+      u[1] = (unsigned int) csr_head(graph, i);
+      fwrite(u, sizeof(unsigned int), 2, file);
+    }
+    else {
+      x[0] = graph->arcs[i].len;
+      x[1] = graph->arcs[i].head;
+      fwrite(x, sizeof(long long), 2, file);
+    }
+  if (graph->x != NULL && graph->y != NULL) {
+    csrWriteLongs(file, graph->x, graph->n);
+    csrWriteLongs(file, graph->y, graph->n);
+  }
+  if (ferror(file) || fclose(file) != 0) {
+    fprintf(stderr, "ERROR: can't write graph file %s\n", fileName);
+    exit(1);
+  }
+}
+
+// copies count values out of the file, where long is narrower than
+// the file's long long
+static long *csrCopyLongs(const long long *a, long count)
+{
+  long *copy = (long *) malloc((count + 1) * sizeof(long));
+  long i;
+
+  if (copy == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+    exit(1);
+  }
+  for (i = 0; i < count; i++)
+    copy[i] = (long) a[i];
+  return copy;
+}
+
+CSRGraph *csr_map_bin(const char *fileName)
+{
+  // the file's arrays are usable in place if they match CSRGraph's
+  const bool inPlace = (sizeof(long) == sizeof(long long) &&
+			sizeof(CSRArc) == 2 * sizeof(long long));
+  CSRGraph *graph;
+  struct stat st;
+  char *map;
+  const long long *head, *first, *arcs, *coords;
+  const CSRArc32 *arcs32;
+  long long n, m, v, a, words, arcWords;
+  int fd, version;
+  bool compact;
+
+  fd = open(fileName, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "ERROR: file %s not found\n", fileName);
+    exit(1);
+  }
+  if (fstat(fd, &st) != 0 || st.st_size < CSR_BIN_HEADER)
+    csrBinError(fileName, "not a graph file");
+  map = (char *) mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == (char *) MAP_FAILED)
+    csrBinError(fileName, "can't map the file");
+  madvise(map, st.st_size, MADV_WILLNEED);
+
+  memcpy(&version, map + 4, sizeof(int));
+  head = (const long long *) (map + 8);
+  n = head[0];
+  m = head[1];
+  if (memcmp(map, "GR\0", 4) != 0)
+    csrBinError(fileName, "not a graph file");
+  if (version != CSR_BIN_VERSION)
+    csrBinError(fileName, "unsupported version");
+  words = (st.st_size - CSR_BIN_HEADER) / (long long) sizeof(long long);
+  if (n < 1 || m < 0 || n >= words || m > words ||
+      (head[2] != 0 && head[2] != 1) || (head[3] != 0 && head[3] != 1))
+    csrBinError(fileName, "bad header");
+  compact = head[3];
+  arcWords = compact ? m : 2 * m;      // a compact arc is one word
+  if (words != n + 1 + arcWords + (head[2] ? 2 * n : 0) ||
+      (st.st_size - CSR_BIN_HEADER) % sizeof(long long) != 0)
+    csrBinError(fileName, "file size does not match the header");
+
+  first = (const long long *) (map + CSR_BIN_HEADER);
+  arcs = first + n + 1;
+  arcs32 = (const CSRArc32 *) arcs;
+  coords = head[2] ? arcs + arcWords : NULL;
+  if (first[0] != 0 || first[n] != m)
+    csrBinError(fileName, "bad arc offsets");
+  for (v = 0; v < n; v++)
+    if (first[v + 1] < first[v])
+      csrBinError(fileName, "bad arc offsets");
+  if (compact) {
+    for (a = 0; a < m; a++)
+      if (arcs32[a].head >= n)
+	csrBinError(fileName, "bad arc");
+  }
+  else
+    for (a = 0; a < 2 * m; a += 2)
+      if (arcs[a] < 0 || arcs[a + 1] < 0 || arcs[a + 1] >= n)
+	csrBinError(fileName, "bad arc");
+
+  graph = (CSRGraph *) malloc(sizeof(CSRGraph));
+  if (graph == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+    exit(1);
+  }
+  graph->n = (long) n;
+  graph->m = (long) m;
+  graph->reverse = NULL;
+  graph->lonLat = false;
+  graph->order = 0;
+  graph->caliber = NULL;
+  graph->map = map;
+  graph->mapSize = st.st_size;
+  // compact arcs are the same everywhere
+  graph->arcs32 = compact ? (CSRArc32 *) arcs32 : NULL;
+  graph->arcs = NULL;
+  if (inPlace) {
+    graph->first = (long *) first;
+    if (!compact)
+      graph->arcs = (CSRArc *) arcs;
+    graph->x = coords ? (long *) coords : NULL;
+    graph->y = coords ? (long *) coords + n : NULL;
+    return graph;
+  }
+
+  graph->first = csrCopyLongs(first, n + 1);
+  if (!compact) {
+    graph->arcs = (CSRArc *) malloc((m + 1) * sizeof(CSRArc));
+    if (graph->arcs == NULL) {
+      fprintf(stderr, "ERROR: can't allocate the CSR graph\n");
+      exit(1);
+    }
+    for (a = 0; a < m; a++) {
+      graph->arcs[a].len = arcs[2 * a];
+      graph->arcs[a].head = (long) arcs[2 * a + 1];
+    }
+  }
+  graph->x = coords ? csrCopyLongs(coords, n) : NULL;
+  graph->y = coords ? csrCopyLongs(coords + n, n) : NULL;
+  return graph;
+}
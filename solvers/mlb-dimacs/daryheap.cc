@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "daryheap.h"
+
+
+template <class KeyType, int D>
+DaryHeap_Wrapper<KeyType, D>::DaryHeap_Wrapper(CSRGraph *graphGiven)
+{
+    graph = graphGiven;
+    if (sizeof(typename HeapNodeId<KeyType>::type) < sizeof(long) &&
+        graph->n > 4294967295LL) {
+        fprintf(stderr, "ERROR: too many nodes for 32-bit heap entries\n");
+        exit(1);
+    }
+    heap = new DaryEntry[graph->n > 0 ? graph->n : 1];
+    count = 0;
+    pos = new long[graph->n];
+    for (long q = 0; q < graph->n; q++)
+        pos[q] = -1;
+}
+
+template <class KeyType, int D>
+DaryHeap_Wrapper<KeyType, D>::~DaryHeap_Wrapper()
+{
+    delete [] heap;
+    delete [] pos;
+}
+
+//moves the hole at slot i up until e fits there
+template <class KeyType, int D>
+inline void DaryHeap_Wrapper<KeyType, D>::SiftUp(long i, DaryEntry e)
+{
+    long parent;
+
+    while (i > 0) {
+        parent = (i - 1) / D;
+        if (heap[parent].key <= e.key)
+            break;
+        heap[i] = heap[parent];
+        pos[heap[i].v] = i;
+        i = parent;
+    }
+    heap[i] = e;
+    pos[e.v] = i;
+}
+
+//moves the hole at slot i down until e fits there
+template <class KeyType, int D>
+inline void DaryHeap_Wrapper<KeyType, D>::SiftDown(long i, DaryEntry e)
+{
+    long child, last, best;
+
+    for (;;) {
+        child = D * i + 1;
+        if (child >= count)
+            break;
+        last = child + D < count ? child + D : count;
+        best = child;
+        for (child++; child < last; child++)
+            if (heap[child].key < heap[best].key)
+                best = child;
+        if (e.key <= heap[best].key)
+            break;
+        heap[i] = heap[best];
+        pos[heap[i].v] = i;
+        i = best;
+    }
+    heap[i] = e;
+    pos[e.v] = i;
+}
+
+template <class KeyType, int D>
+void DaryHeap_Wrapper<KeyType, D>::Clear()
+{
+    for (long i = 0; i < count; i++)
+        pos[heap[i].v] = -1;
+    count = 0;
+}
+
+template <class KeyType, int D>
+void DaryHeap_Wrapper<KeyType, D>::Push(long v, long long key)
+{
+    DaryEntry e;
+
+    e.key = (KeyType) key;
+    e.v = (typename HeapNodeId<KeyType>::type) v;
+    SiftUp(count++, e);
+}
+
+template <class KeyType, int D>
+void DaryHeap_Wrapper<KeyType, D>::Decrease(long v, long long key)
+{
+    DaryEntry e;
+
+    e.key = (KeyType) key;
+    e.v = (typename HeapNodeId<KeyType>::type) v;
+    SiftUp(pos[v], e);
+}
+
+template <class KeyType, int D>
+long DaryHeap_Wrapper<KeyType, D>::PopMin()
+{
+    long v;
+
+    if (count == 0)
+        return -1;
+    v = heap[0].v;
+    pos[v] = -1;
+    if (--count > 0)
+        SiftDown(0, heap[count]);
+    return v;
+}
+
+template <class KeyType, int D>
+long long DaryHeap_Wrapper<KeyType, D>::MinKey()
+{
+    return heap[0].key;
+}
+
+template <class KeyType, int D>
+bool DaryHeap_Wrapper<KeyType, D>::IsEmpty()
+{
+    return count == 0;
+}
+
+//the two key widths the driver chooses from, for each arity
+template class DaryHeap_Wrapper<int, 2>;
+template class DaryHeap_Wrapper<long long, 2>;
+template class DaryHeap_Wrapper<int, 4>;
+template class DaryHeap_Wrapper<long long, 4>;
+template class DaryHeap_Wrapper<int, 8>;
+template class DaryHeap_Wrapper<long long, 8>;
@@ -0,0 +1,69 @@
+#ifndef DARYHEAP_H
+#define DARYHEAP_H
+
+#include "nodearc.h"
+#include "csr.h"
+#include "sp.h" //get shortest path wrapper class
+
+#ifndef ulong
+typedef unsigned long ulong; // to get that extra bit
+#endif
+
+//Implicit d-ary heap: (key, node) pairs packed in one array, the
+//children of slot i in slots D*i+1 .. D*i+D, and pos[v] the slot of
+//node v for decrease-key.  No per-node heap objects or pointers, so
+//a sift touches a few contiguous cache lines; a wider D means a
+//shallower heap and fewer of them.  KeyType is int or long long as
+//for the other heaps, and picks the width of the node id in an
+//entry (HeapNodeId, csr.h); instantiations live in daryheap.cc.
+
+template <class KeyType, int D>
+class DaryHeap_Wrapper{
+public:
+    typedef struct DaryEntry {
+        KeyType key;
+        typename HeapNodeId<KeyType>::type v;
+    } DaryEntry;
+private:
+    CSRGraph *graph;  //shared, read-only
+    DaryEntry *heap;  //heap[0 .. count-1]
+    long count;
+    long *pos;        //pos[v] is the slot of node v, or -1
+
+    void SiftUp(long i, DaryEntry e);
+    void SiftDown(long i, DaryEntry e);
+public:
+    DaryHeap_Wrapper(CSRGraph *graph);
+
+    ~DaryHeap_Wrapper();
+    //queue interface the searches run on (HeapEngine in engine.cc,
+    //bidir.h and the others); v is a node index, keys are distances
+    void Clear();
+    void Push(long v, long long key);
+    void Decrease(long v, long long key);
+    long PopMin();             //-1 if empty
+    long long MinKey();        //must not be empty
+    bool IsEmpty();
+};
+
+//the arities offered as backends, each a one-parameter template
+//like the other wrappers (see heapEngine() in engine.cc)
+template <class KeyType>
+class Dary2Heap_Wrapper : public DaryHeap_Wrapper<KeyType, 2> {
+public:
+    Dary2Heap_Wrapper(CSRGraph *graph) : DaryHeap_Wrapper<KeyType, 2>(graph) {}
+};
+
+template <class KeyType>
+class Dary4Heap_Wrapper : public DaryHeap_Wrapper<KeyType, 4> {
+public:
+    Dary4Heap_Wrapper(CSRGraph *graph) : DaryHeap_Wrapper<KeyType, 4>(graph) {}
+};
+
+template <class KeyType>
+class Dary8Heap_Wrapper : public DaryHeap_Wrapper<KeyType, 8> {
+public:
+    Dary8Heap_Wrapper(CSRGraph *graph) : DaryHeap_Wrapper<KeyType, 8>(graph) {}
+};
+
+#endif
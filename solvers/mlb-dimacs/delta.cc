@@ -0,0 +1,335 @@
+// delta.cc
+//     Delta-stepping engine (see delta.h).  All threads run
+//     deltaWork() in lock step: every decision between barriers is
+//     taken from data no thread writes until the next barrier, so
+//     they all agree on the bucket and on when a phase is over.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <vector>
+#include "delta.h"
+
+#define DELTA_MAX_BUCKETS   (1L << 20)   // bounds delta from below
+
+typedef struct DeltaRequest {
+  long v;                    // node to relax
+  long from;                 // its parent if the relaxation succeeds
+  long long dist;
+} DeltaRequest;
+
+typedef struct DeltaThread {
+  struct DeltaShared *shared;
+  int id;
+  std::vector<long> *bucket;          // circular, shared->nBuckets
+  std::vector<long> frontier;         // taken from the current bucket
+  std::vector<long> settled;          // nodes of the current bucket
+  std::vector<DeltaRequest> *out;     // posted to each thread
+  long long next;            // lowest nonempty own bucket, or -1
+  bool refilled[2];          // current bucket refilled, by phase parity
+  long long scans, updates, requests;
+} DeltaThread;
+
+struct DeltaShared {
+  CSRGraph *graph;
+  Node *nodes;
+  long *parent;
+  SP *sp;
+  int threads;
+  long block;                // nodes per thread
+  ulong logDelta;
+  long long delta;
+  long nBuckets;             // power of two
+  long long *bucketOf;       // live bucket of each node, or -1
+  DeltaThread *thread;
+  pthread_barrier_t barrier;
+
+  long long statBuckets;     // buckets settled
+  long long statPhases;      // light phases
+  long long statRequests;    // relaxations posted to another thread
+};
+
+//-------------------------------------------------------------
+// deltaRelax()
+//     Lowers the label of v, owned by the calling thread, and moves
+//     it to its new bucket.  A node is put in a bucket once; later
+//     entries for it elsewhere are skipped as stale.
+//-------------------------------------------------------------
+
+static inline void deltaRelax(DeltaThread *me, long long cur, int parity,
+			      long v, long from, long long newDist)
+{
+  DeltaShared *d = me->shared;
+  Node *w = d->nodes + v;
+  long long b;
+
+  if (w->tStamp != d->sp->curTime) {
+    d->sp->initNode(w);
+    d->bucketOf[v] = -1;
+  }
+  if (newDist < w->dist) {
+    w->dist = newDist;
+    d->parent[v] = from;
+    me->updates++;
+    b = newDist >> d->logDelta;
+    if (d->bucketOf[v] != b) {
+      d->bucketOf[v] = b;
+      me->bucket[b & (d->nBuckets - 1)].push_back(v);
+    }
+    if (b == cur)
+      me->refilled[parity] = true;
+  }
+}
+
+// relaxes the light or the heavy arcs out of u, arcs being the
+// graph's arcs in either layout
+template <class Arc>
+static void deltaScanArcs(DeltaThread *me, long long cur, int parity, long u,
+			  bool light, const Arc *arcs)
+{
+  DeltaShared *d = me->shared;
+  CSRGraph *g = d->graph;
+  const Arc *arc, *lastArc;
+  long long uDist = d->nodes[u].dist;
+  DeltaRequest request;
+  int owner;
+
+  lastArc = arcs + g->first[u + 1];
+  for (arc = arcs + g->first[u]; arc < lastArc; arc++) {
+    if ((arc->len <= d->delta) != light)
+      continue;
+    owner = (int) (arc->head / d->block);
+    if (owner == me->id)
+      deltaRelax(me, cur, parity, arc->head, u, uDist + arc->len);
+    else {
+      request.v = arc->head;
+      request.from = u;
+      request.dist = uDist + arc->len;
+      me->out[owner].push_back(request);
+      me->requests++;
+    }
+  }
+}
+
+static void deltaScan(DeltaThread *me, long long cur, int parity, long u,
+		      bool light)
+{
+  CSRGraph *g = me->shared->graph;
+
+  if (g->arcs32 != NULL)
+    deltaScanArcs(me, cur, parity, u, light, g->arcs32);
+  else
+    deltaScanArcs(me, cur, parity, u, light, g->arcs);
+}
+
+// applies the requests posted to the calling thread
+static void deltaApply(DeltaThread *me, long long cur, int parity)
+{
+  DeltaShared *d = me->shared;
+  std::vector<DeltaRequest> *in;
+  size_t i;
+  int t;
+
+  for (t = 0; t < d->threads; t++) {
+    in = d->thread[t].out + me->id;
+    for (i = 0; i < in->size(); i++)
+      deltaRelax(me, cur, parity, (*in)[i].v, (*in)[i].from, (*in)[i].dist);
+    in->clear();
+  }
+}
+
+static void *deltaWork(void *arg)
+{
+  DeltaThread *me = (DeltaThread *) arg;
+  DeltaShared *d = me->shared;
+  long mask = d->nBuckets - 1;
+  long long cur = 0, b;
+  size_t i;
+  long u;
+  int t, parity = 0;
+  bool more;
+
+  for (;;) {
+    // the next bucket is the lowest nonempty one of any thread
+    me->next = -1;
+    for (b = cur; b < cur + d->nBuckets; b++)
+      if (!me->bucket[b & mask].empty()) {
+	me->next = b;
+	break;
+      }
+    pthread_barrier_wait(&d->barrier);
+    cur = -1;
+    for (t = 0; t < d->threads; t++)
+      if (d->thread[t].next >= 0 && (cur < 0 || d->thread[t].next < cur))
+	cur = d->thread[t].next;
+    if (cur < 0)
+      break;
+    if (me->id == 0)
+      d->statBuckets++;
+
+    // light phases until no thread puts a node back in bucket cur
+    me->settled.clear();
+    do {
+      me->refilled[parity] = false;
+      me->frontier.swap(me->bucket[cur & mask]);
+      for (i = 0; i < me->frontier.size(); i++) {
+	u = me->frontier[i];
+	if (d->bucketOf[u] != cur)
+	  continue;                   // stale
+	d->bucketOf[u] = -1;
+	if (d->nodes[u].where != IN_SCANNED) {
+	  d->nodes[u].where = IN_SCANNED;
+	  me->settled.push_back(u);
+	}
+	me->scans++;
+	deltaScan(me, cur, parity, u, true);
+      }
+      me->frontier.clear();
+      pthread_barrier_wait(&d->barrier);
+      deltaApply(me, cur, parity);
+      pthread_barrier_wait(&d->barrier);
+      more = false;
+      for (t = 0; t < d->threads; t++)
+	more = more || d->thread[t].refilled[parity];
+      parity = 1 - parity;
+      if (me->id == 0)
+	d->statPhases++;
+    } while (more);
+
+    // heavy arcs only reach later buckets: one pass
+    for (i = 0; i < me->settled.size(); i++)
+      deltaScan(me, cur, parity, me->settled[i], false);
+    pthread_barrier_wait(&d->barrier);
+    deltaApply(me, cur, parity);
+  }
+  return NULL;
+}
+
+//-------------------------------------------------------------
+// DeltaEngine
+//-------------------------------------------------------------
+
+DeltaEngine::DeltaEngine(CSRGraph *graphGiven, int threadsGiven,
+			 ulong logDeltaGiven)
+{
+  DeltaShared *d;
+  long long minArcLen, maxArcLen, width;
+  long need;
+  int t;
+
+  graph = graphGiven;
+  threads = threadsGiven < 1 ? 1 : threadsGiven;
+  if (threads > graph->n)
+    threads = graph->n > 0 ? (int) graph->n : 1;
+
+  // about one light arc per node and bucket: delta near the maximum
+  // arc length divided by the average degree (maxArcLen * n / m),
+  // rounded down to a power of two, but no shorter than any arc
+  ArcLen(graph, &minArcLen, &maxArcLen);
+  if (logDeltaGiven > 0)
+    logDelta = logDeltaGiven;
+  else {
+    width = graph->m > 0 ?
+      (long long) (maxArcLen * (double) graph->n / (double) graph->m) : 1;
+    if (width < minArcLen)
+      width = minArcLen;
+    for (logDelta = 0; (2LL << logDelta) <= width; logDelta++)
+      ;
+  }
+  while ((maxArcLen >> logDelta) + 2 > DELTA_MAX_BUCKETS)
+    logDelta++;
+
+  shared = d = new DeltaShared;
+  d->graph = graph;
+  d->threads = threads;
+  d->block = (graph->n + threads - 1) / threads;
+  if (d->block < 1)
+    d->block = 1;
+  d->logDelta = logDelta;
+  d->delta = 1LL << logDelta;
+  need = (long) (maxArcLen >> logDelta) + 2;
+  for (d->nBuckets = 1; d->nBuckets < need; d->nBuckets <<= 1)
+    ;
+  d->bucketOf = new long long[graph->n];
+  d->thread = new DeltaThread[threads];
+  for (t = 0; t < threads; t++) {
+    d->thread[t].shared = d;
+    d->thread[t].id = t;
+    d->thread[t].bucket = new std::vector<long>[d->nBuckets];
+    d->thread[t].out = new std::vector<DeltaRequest>[threads];
+  }
+  pthread_barrier_init(&d->barrier, NULL, threads);
+  d->statBuckets = d->statPhases = d->statRequests = 0;
+}
+
+DeltaEngine::~DeltaEngine()
+{
+  int t;
+
+  pthread_barrier_destroy(&shared->barrier);
+  for (t = 0; t < threads; t++) {
+    delete [] shared->thread[t].bucket;
+    delete [] shared->thread[t].out;
+  }
+  delete [] shared->thread;
+  delete [] shared->bucketOf;
+  delete shared;
+}
+
+SPEngine *DeltaEngine::Clone(Node *)
+{
+  return new DeltaEngine(graph, threads, logDelta);
+}
+
+bool DeltaEngine::run(Node *source, Node *sink, SP *sp)
+{
+  DeltaShared *d = shared;
+  DeltaThread *thread;
+  pthread_t *tid;
+  long s;
+  int t;
+
+  d->nodes = sp->getNodes();
+  d->parent = sp->getParents();
+  d->sp = sp;
+  sp->curTime++;
+  source->tStamp = sp->curTime;     // initS has set dist and parent
+
+  s = source - d->nodes;
+  d->bucketOf[s] = 0;
+  d->thread[s / d->block].bucket[0].push_back(s);
+  for (t = 0; t < threads; t++) {
+    thread = d->thread + t;
+    thread->refilled[0] = thread->refilled[1] = false;
+    thread->scans = thread->updates = thread->requests = 0;
+  }
+
+  tid = new pthread_t[threads];
+  for (t = 1; t < threads; t++)
+    if (pthread_create(tid + t, NULL, deltaWork, d->thread + t) != 0) {
+      fprintf(stderr, "ERROR: can't start a delta-stepping thread\n");
+      exit(1);
+    }
+  deltaWork(d->thread);
+  for (t = 1; t < threads; t++)
+    pthread_join(tid[t], NULL);
+  delete [] tid;
+
+  for (t = 0; t < threads; t++) {
+    sp->cScans += d->thread[t].scans;
+    sp->cUpdates += d->thread[t].updates;
+    d->statRequests += d->thread[t].requests;
+  }
+  return sink == NULL || sink->tStamp == sp->curTime;
+}
+
+void DeltaEngine::PrintStats(long tries)
+{
+  fprintf(stderr, "c Delta: %21lld       Threads: %19d\n",
+	  shared->delta, threads);
+  fprintf(stderr, "c Buckets (ave): %16.1f     Phases (ave): %16.1f\n",
+	  (float) shared->statBuckets / (float) tries,
+	  (float) shared->statPhases / (float) tries);
+  fprintf(stderr, "c Requests (ave): %15.1f\n",
+	  (float) shared->statRequests / (float) tries);
+}
@@ -0,0 +1,45 @@
+// delta.h
+//     Delta-stepping (Meyer and Sanders): one-to-all search by
+//     several threads at once.  Tentative distances are kept in
+//     buckets of width delta = 2^logDelta, as the bottom level of a
+//     smart queue; the lowest nonempty bucket is settled in phases.
+//     Each phase relaxes the light arcs (len <= delta) of the nodes
+//     that entered the bucket, which may refill it; once it stays
+//     empty, the heavy arcs of all nodes it settled are relaxed
+//     once, since they can only reach later buckets.
+//
+//     Nodes are split into one block per thread, and a thread alone
+//     touches the labels and buckets of its block.  Relaxing an arc
+//     into another block posts a request to that block's thread;
+//     requests are applied after a barrier, so no label needs a lock.
+//     The buckets form a circular array of (maxArcLen / delta) + 2
+//     entries, each a list of node ids; an entry is stale if the
+//     node has since moved to another bucket.
+//
+//     delta defaults to max(minArcLen, maxArcLen / average degree)
+//     rounded down to a power of two; a log delta given on the
+//     command line overrides it.
+
+#ifndef DELTA_H
+#define DELTA_H
+
+#include "sp.h"
+
+struct DeltaShared;        // defined in delta.cc
+
+class DeltaEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   int threads;
+   ulong logDelta;
+   DeltaShared *shared;      // buckets and buffers, kept between runs
+ public:
+   // logDeltaGiven 0: pick delta from the arc lengths
+   DeltaEngine(CSRGraph *graphGiven, int threadsGiven, ulong logDeltaGiven);
+   ~DeltaEngine();
+   SPEngine *Clone(Node *nodes);
+   bool run(Node *source, Node *sink, SP *sp);
+   void PrintStats(long tries);
+};
+
+#endif
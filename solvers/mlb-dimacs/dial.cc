@@ -0,0 +1,158 @@
+// dial.cc
+//     Dial's circular buckets; see dial.h.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "dial.h"
+
+DialEngine::DialEngine(CSRGraph *graphGiven)
+{
+  long long maxArcLen;
+  long i;
+
+  graph = graphGiven;
+  ArcLen(graph, NULL, &maxArcLen);
+  if (maxArcLen >= DIAL_MAX_BUCKETS) {
+    fprintf(stderr, "ERROR: MaxArcLen %lld is too large for dial\n",
+	    maxArcLen);
+    exit(1);
+  }
+  nBuckets = (long) maxArcLen + 1;
+  bucket = new Node *[nBuckets];
+  for (i = 0; i < nBuckets; i++)
+    bucket[i] = NULL;
+  link = new DialLink[graph->n > 0 ? graph->n : 1];
+  statEmpty = 0;
+}
+
+DialEngine::~DialEngine()
+{
+  delete [] bucket;
+  delete [] link;
+}
+
+SPEngine *DialEngine::Clone(Node *)
+{
+  return new DialEngine(graph);
+}
+
+bool DialEngine::run(Node *source, Node *sink, SP *sp)
+{
+  if (graph->arcs32 != NULL) {
+    if (sink == NULL)
+      return dijkstra<false>(source, NULL, sp, graph->arcs32);
+    return dijkstra<true>(source, sink, sp, graph->arcs32);
+  }
+  if (sink == NULL)
+    return dijkstra<false>(source, NULL, sp, graph->arcs);
+  return dijkstra<true>(source, sink, sp, graph->arcs);
+}
+
+void DialEngine::PrintStats(long tries)
+{
+  fprintf(stderr, "c Buckets: %22ld       Empty (ave): %15.1f\n",
+	  nBuckets, (float) statEmpty / (float) tries);
+}
+
+//-------------------------------------------------------------
+// DialEngine::dijkstra()
+//     cur is the bucket of the distance being scanned; a node
+//     reached over an arc of length len goes len buckets further
+//     on, so no distance is ever reduced modulo C+1.  Labels are
+//     set up lazily by time stamp as for the heaps.  A one-to-all
+//     search runs the buckets dry; a single-pair one may stop with
+//     nodes still queued, so it records each bucket it makes
+//     nonempty and clears just those heads on the way out (the
+//     nodes are reset by their stamps).
+//-------------------------------------------------------------
+
+template <bool SinglePair, class Arc>
+bool DialEngine::dijkstra(Node *source, Node *sink, SP *sp, const Arc *arcs)
+{
+  const Arc *arc, *lastArc;
+  Node *allRaw = sp->getNodes(), *u, *w, *next, **head;
+  DialLink *lu, *lw;
+  long *parent = sp->getParents();
+  long cur, to, queued;
+  size_t i;
+  long long newDist;
+
+  sp->curTime++;
+  source->tStamp = sp->curTime;
+
+  cur = 0;
+  lu = link + (source - allRaw);
+  lu->next = lu->prev = NULL;
+  lu->head = bucket;
+  source->where = IN_BUCKETS;
+  bucket[0] = source;
+  if (SinglePair)
+    filled.push_back(0);
+  queued = 1;
+
+  while (queued > 0) {
+    while ((u = bucket[cur]) == NULL) {
+      if (++cur == nBuckets)
+	cur = 0;
+      statEmpty++;
+    }
+    // remove u from the front of its bucket
+    bucket[cur] = next = link[u - allRaw].next;
+    if (next)
+      link[next - allRaw].prev = NULL;
+    queued--;
+
+    u->where = IN_SCANNED;
+    if (SinglePair && u == sink) {
+      for (i = 0; i < filled.size(); i++)
+	bucket[filled[i]] = NULL;
+      filled.clear();
+      return true;
+    }
+    sp->cScans++;
+
+    // scan node
+    lastArc = arcs + graph->first[u - allRaw + 1];
+    for (arc = arcs + graph->first[u - allRaw]; arc < lastArc; arc++) {
+      w = allRaw + arc->head;
+      lw = link + arc->head;
+      if (w->tStamp != sp->curTime)
+	sp->initNode(w);        // first touch in this query
+      newDist = u->dist + arc->len;
+      if (newDist < w->dist) {
+	if (w->where == IN_BUCKETS) {
+	  // unlink w from its old bucket
+	  next = lw->next;
+	  if (lw->prev)
+	    link[lw->prev - allRaw].next = next;
+	  else
+	    *lw->head = next;
+	  if (next)
+	    link[next - allRaw].prev = lw->prev;
+	}
+	else {
+	  w->where = IN_BUCKETS;
+	  queued++;
+	}
+	w->dist = newDist;
+	parent[arc->head] = u - allRaw;
+
+	to = cur + (long) arc->len;
+	if (to >= nBuckets)
+	  to -= nBuckets;
+	head = bucket + to;
+	lw->head = head;
+	lw->prev = NULL;
+	lw->next = *head;
+	if (*head)
+	  link[*head - allRaw].prev = w;
+	else if (SinglePair)
+	  filled.push_back(to);
+	*head = w;
+	sp->cUpdates++;
+      }
+    }
+  }
+  filled.clear();
+  return !SinglePair;           // ran dry before reaching the sink
+}
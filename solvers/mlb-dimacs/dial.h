@@ -0,0 +1,50 @@
+// dial.h
+//     Dial's algorithm: one-to-all and single-pair search with a
+//     circular array of C+1 buckets, C the largest arc length.  The
+//     tentative distances of labeled nodes all lie within C of the
+//     one being scanned, so bucket d mod (C+1) holds exactly the
+//     nodes at distance d.  A bucket is a doubly linked list through
+//     a DialLink per node, whose head field points at the list head,
+//     so insert and delete are O(1) and the search is O(m + nC) with
+//     no key comparisons at all.  A single-pair search that stops
+//     early empties only the buckets it filled, so a query costs
+//     nothing per bucket it never reached.
+//
+//     Worth it only when C is small: spAutoQueue() (engine.cc)
+//     picks it when no queue is named and C <= DIAL_AUTO_MAX_LEN.
+
+#ifndef DIAL_H
+#define DIAL_H
+
+#include <vector>
+#include "sp.h"
+
+#define DIAL_AUTO_MAX_LEN   1024       // auto-selected up to this C
+#define DIAL_MAX_BUCKETS    (1L << 24) // refused beyond this C + 1
+
+typedef struct DialLink {
+   Node *next;               // next in bucket
+   Node *prev;               // prev in bucket, NULL for the first
+   Node **head;              // our bucket, if where == IN_BUCKETS
+} DialLink;
+
+class DialEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   long nBuckets;            // C + 1
+   Node **bucket;            // list heads, all NULL between runs
+   std::vector<long> filled; // buckets made nonempty, single-pair
+   DialLink *link;           // per node, indexed like the labels
+   long long statEmpty;      // empty buckets passed over
+
+   template <bool SinglePair, class Arc>
+   bool dijkstra(Node *source, Node *sink, SP *sp, const Arc *arcs);
+ public:
+   DialEngine(CSRGraph *graphGiven);
+   ~DialEngine();
+   SPEngine *Clone(Node *nodes);
+   bool run(Node *source, Node *sink, SP *sp);
+   void PrintStats(long tries);
+};
+
+#endif
@@ -0,0 +1,410 @@
+// engine.cc
+//     Registry of queue backends.  Each entry names a backend and the
+//     modes it supports; spNewEngine() instantiates the matching
+//     engine template.  To add a backend, add an SP_DIK_* constant in
+//     engine.h, a line to spQueues[] and a case to spNewEngine(); a
+//     heap wrapper with the Push/Decrease/PopMin interface gets every
+//     mode from heapEngine().
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "sp.h"
+#include "bidir.h"
+#include "astar.h"
+#include "alt.h"
+#include "ch.h"
+#include "arcflags.h"
+#include "delta.h"
+#include "dial.h"
+#include "caliber.h"
+
+#define MODE_BIT(mode)      (1 << (mode))
+
+SPQueueInfo spQueues[] = {
+  { "fib",      SP_DIK_FIBHEAP, "Dijkstra with Fibonacci Heap",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "binomial", SP_DIK_BINHEAP, "Dijkstra with Binomial Queue",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "smartq",   SP_DIK_SMARTQ,  "Dijkstra with Smart Queues",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) },
+  { "mlb",      SP_DIK_MLB,     "Dijkstra with Multi-Level Buckets",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) },
+  { "radix",    SP_DIK_RADIX,   "Dijkstra with Radix Heap",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "dary2",    SP_DIK_DARY2,   "Dijkstra with Binary Heap (implicit)",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "dary4",    SP_DIK_DARY4,   "Dijkstra with 4-ary Heap (implicit)",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "dary8",    SP_DIK_DARY8,   "Dijkstra with 8-ary Heap (implicit)",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "pairing",  SP_DIK_PAIRING, PAIRING_DESC,
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) | MODE_BIT(SP_MODE_BIDIR) |
+    MODE_BIT(SP_MODE_ASTAR) | MODE_BIT(SP_MODE_ALT) | MODE_BIT(SP_MODE_CH) |
+    MODE_BIT(SP_MODE_ARCFLAGS) },
+  { "delta",    SP_DIK_DELTA,   "Parallel Delta-Stepping",
+    MODE_BIT(SP_MODE_SS) },
+  { "dial",     SP_DIK_DIAL,    "Dijkstra with Dial's Buckets",
+    MODE_BIT(SP_MODE_SS) | MODE_BIT(SP_MODE_P2P) },
+  { NULL, 0, NULL, 0 }
+};
+
+void spDefaultParams(SPParams *params)
+{
+  params->levels = 0;
+  params->logDelta = 0;
+  params->wideKeys = true;
+  params->caliber = false;
+  params->altMethod = 0;
+  params->altCount = 16;
+  params->altFile = NULL;
+  params->chContract = false;
+  params->chFile = NULL;
+  params->afMethod = 0;
+  params->afCells = 64;
+  params->afFile = NULL;
+  params->threads = 1;
+}
+
+SPQueueInfo *spFindQueue(const char *name)
+{
+  SPQueueInfo *q;
+
+  for (q = spQueues; q->name != NULL; q++)
+    if (strcmp(q->name, name) == 0)
+      return q;
+  return NULL;
+}
+
+SPQueueInfo *spAutoQueue(CSRGraph *graph, int mode)
+{
+  long long maxArcLen;
+
+  if (mode == SP_MODE_SS || mode == SP_MODE_P2P) {
+    ArcLen(graph, NULL, &maxArcLen);
+    if (maxArcLen <= DIAL_AUTO_MAX_LEN)
+      return spFindQueue("dial");
+  }
+  return spFindQueue(SP_DEFAULT_QUEUE);
+}
+
+const char *spModeName(int mode)
+{
+  switch (mode) {
+  case SP_MODE_SS:  return "ss";
+  case SP_MODE_P2P: return "p2p";
+  case SP_MODE_BIDIR: return "bidir";
+  case SP_MODE_ASTAR: return "astar";
+  case SP_MODE_ALT:   return "alt";
+  case SP_MODE_CH:    return "ch";
+  case SP_MODE_ARCFLAGS: return "arcflags";
+  }
+  return "unknown";
+}
+
+int spFindMode(const char *name)
+{
+  if (strcmp(name, "ss") == 0)  return SP_MODE_SS;
+  if (strcmp(name, "p2p") == 0) return SP_MODE_P2P;
+  if (strcmp(name, "bidir") == 0) return SP_MODE_BIDIR;
+  if (strcmp(name, "astar") == 0) return SP_MODE_ASTAR;
+  if (strcmp(name, "alt") == 0)   return SP_MODE_ALT;
+  if (strcmp(name, "ch") == 0)    return SP_MODE_CH;
+  if (strcmp(name, "arcflags") == 0) return SP_MODE_ARCFLAGS;
+  return 0;
+}
+
+//-------------------------------------------------------------
+// HeapEngine
+//     Dijkstra with one of the heap wrappers, through the same
+//     Clear/Push/Decrease/PopMin interface as bidir.h and caliber.h;
+//     Wrapper is the wrapper instantiated for the chosen key width.
+//     Searches scan the compact arcs whenever the graph has them
+//     (csr.h).
+//-------------------------------------------------------------
+
+template <class Wrapper>
+class HeapEngine : public SPEngine {
+ private:
+   CSRGraph *graph;
+   Wrapper *heap;
+
+   template <bool SinglePair, class Arc>
+   bool dijkstra(Node *source, Node *sink, SP *sp, const Arc *arcs);
+ public:
+   HeapEngine(CSRGraph *graphGiven)
+   {
+     graph = graphGiven;
+     heap = new Wrapper(graph);
+   }
+   ~HeapEngine()                       { delete heap; }
+   SPEngine *Clone(Node *)             { return new HeapEngine(graph); }
+   bool run(Node *source, Node *sink, SP *sp)
+   {
+     if (graph->arcs32 != NULL) {
+       if (sink == NULL)
+	 return dijkstra<false>(source, NULL, sp, graph->arcs32);
+       return dijkstra<true>(source, sink, sp, graph->arcs32);
+     }
+     if (sink == NULL)
+       return dijkstra<false>(source, NULL, sp, graph->arcs);
+     return dijkstra<true>(source, sink, sp, graph->arcs);
+   }
+};
+
+//-------------------------------------------------------------
+// HeapEngine::dijkstra()
+//     Nodes enter the heap only when first relaxed.  Per-node state
+//     is validated by Node::tStamp against sp->curTime, so a query
+//     costs time proportional to the part of the graph it touches,
+//     not to n.  A single-pair query (SinglePair) ends when the sink
+//     leaves the heap: its distance is final then, and the rest of
+//     the graph is never touched.  Returns false if the sink is
+//     unreachable; a one-to-all query (sink NULL) returns true.
+//-------------------------------------------------------------
+
+template <class Wrapper>
+template <bool SinglePair, class Arc>
+bool HeapEngine<Wrapper>::dijkstra(Node *source, Node *sink, SP *sp,
+				   const Arc *arcs)
+{
+  const Arc *arc, *lastArc;
+  Node *nodes = sp->getNodes(), *u, *w;
+  long *parent = sp->getParents();
+  long long newDist;
+  long v;
+
+  sp->curTime++;
+  heap->Clear();                  // leftovers of the last query are dropped
+  source->tStamp = sp->curTime;
+  heap->Push(source - nodes, 0);
+  source->where = IN_HEAP;
+
+  while ((v = heap->PopMin()) >= 0) {
+    u = nodes + v;
+    u->where = IN_SCANNED;
+    if (SinglePair && u == sink)
+      return true;
+    sp->cScans++;
+
+    // scan node
+    lastArc = arcs + graph->first[v + 1];
+    for (arc = arcs + graph->first[v]; arc < lastArc; arc++) {
+      w = nodes + arc->head;
+      if (w->tStamp != sp->curTime)
+	sp->initNode(w);          // first touch in this query
+      newDist = u->dist + arc->len;
+      if (newDist < w->dist) {
+	w->dist = newDist;
+	parent[arc->head] = v;
+	if (w->where == IN_HEAP)
+	  heap->Decrease(arc->head, newDist);
+	else {
+	  heap->Push(arc->head, newDist);
+	  w->where = IN_HEAP;
+	}
+	sp->cUpdates++;
+      }
+    }
+  }
+  return !SinglePair;             // ran dry before reaching the sink
+}
+
+//-------------------------------------------------------------
+// SmartQEngine
+//     Smart queues (MLB false) or plain multi-level buckets.
+//-------------------------------------------------------------
+
+template <bool MLB>
+class SmartQEngine : public SPEngine {
+ private:
+   SmartQ *smartq;
+   CSRGraph *graph;
+   ulong levels, logDelta;
+ public:
+   SmartQEngine(CSRGraph *graphGiven, Node *nodes, ulong levelsGiven,
+		ulong logDeltaGiven)
+   {
+     long long minArcLen, maxArcLen;
+
+     graph = graphGiven;
+     levels = levelsGiven;
+     logDelta = logDeltaGiven;
+     ArcLen(graph, &minArcLen, &maxArcLen);
+     smartq = new SmartQ(&minArcLen, &maxArcLen, levels, logDelta,
+			 graph, nodes, !MLB);
+   }
+   ~SmartQEngine()                     { delete smartq; }
+   SPEngine *Clone(Node *nodes)
+   {
+     return new SmartQEngine(graph, nodes, levels, logDelta);
+   }
+   bool run(Node *source, Node *sink, SP *sp)
+   {
+     if (graph->arcs32 != NULL) {
+       if (sink == NULL)
+	 return smartq->dijkstra<MLB, false>(source, NULL, sp, graph->arcs32);
+       return smartq->dijkstra<MLB, true>(source, sink, sp, graph->arcs32);
+     }
+     if (sink == NULL)
+       return smartq->dijkstra<MLB, false>(source, NULL, sp, graph->arcs);
+     return smartq->dijkstra<MLB, true>(source, sink, sp, graph->arcs);
+   }
+   void PrintStats(long tries)         { smartq->PrintStats(tries); }
+};
+
+//-------------------------------------------------------------
+// ALT engines come in eight flavors: queue, key width and table
+// width.  altEngine() settles the last two.
+//-------------------------------------------------------------
+
+template <template <class> class Wrapper>
+static SPEngine *altEngine(CSRGraph *graph, int type, SPParams *params)
+{
+  if (altWideTables(graph, params)) {
+    typedef LandmarkPotential<unsigned long long> Potential;
+    Potential *potential = altLoad<unsigned long long>(graph, type, params);
+    if (params->wideKeys)
+      return new AStarEngine<Wrapper<long long>, Potential>(graph, potential);
+    return new AStarEngine<Wrapper<int>, Potential>(graph, potential);
+  }
+  else {
+    typedef LandmarkPotential<unsigned int> Potential;
+    Potential *potential = altLoad<unsigned int>(graph, type, params);
+    if (params->wideKeys)
+      return new AStarEngine<Wrapper<long long>, Potential>(graph, potential);
+    return new AStarEngine<Wrapper<int>, Potential>(graph, potential);
+  }
+}
+
+//-------------------------------------------------------------
+// The hierarchy is always built with 64-bit witness queues; only
+// the query queues follow the key width.
+//-------------------------------------------------------------
+
+template <template <class> class Wrapper>
+static SPEngine *chEngine(CSRGraph *graph, SPParams *params)
+{
+  CHGraph *ch;
+
+  if (params->chContract) {
+    ch = chBuild<Wrapper<long long> >(graph, params->threads);
+    if (params->chFile)
+      chWrite(ch, graph, params->chFile);
+  }
+  else if (params->chFile)
+    ch = chRead(params->chFile, graph);
+  else {
+    fprintf(stderr, "ERROR: ch needs a hierarchy file or --contract\n");
+    exit(1);
+  }
+  if (params->wideKeys)
+    return new CHEngine<Wrapper<long long> >(graph, ch);
+  return new CHEngine<Wrapper<int> >(graph, ch);
+}
+
+//-------------------------------------------------------------
+// heapEngine()
+//     Any heap wrapper serves every mode through the same queue
+//     interface; only the key width is left to settle.
+//-------------------------------------------------------------
+
+template <template <class> class Wrapper>
+static SPEngine *heapEngine(int type, int mode, CSRGraph *graph,
+			    SPParams *params)
+{
+  bool wideKeys = params->wideKeys;
+
+  if (params->caliber && mode != SP_MODE_SS && mode != SP_MODE_P2P) {
+    fprintf(stderr, "ERROR: calibers are for modes ss and p2p only\n");
+    exit(1);
+  }
+  switch (mode) {
+  case SP_MODE_BIDIR:
+    if (wideKeys)
+      return new BidirEngine<Wrapper<long long> >(graph);
+    return new BidirEngine<Wrapper<int> >(graph);
+  case SP_MODE_ASTAR:
+    if (wideKeys)
+      return new AStarEngine<Wrapper<long long>, CoordPotential>
+	(graph, new CoordPotential(graph));
+    return new AStarEngine<Wrapper<int>, CoordPotential>
+      (graph, new CoordPotential(graph));
+  case SP_MODE_ALT:
+    return altEngine<Wrapper>(graph, type, params);
+  case SP_MODE_CH:
+    return chEngine<Wrapper>(graph, params);
+  case SP_MODE_ARCFLAGS:
+    if (wideKeys)
+      return new ArcFlagEngine<Wrapper<long long> >
+	(graph, afLoad(graph, type, params));
+    return new ArcFlagEngine<Wrapper<int> >
+      (graph, afLoad(graph, type, params));
+  }
+  if (params->caliber) {
+    if (wideKeys)
+      return new CaliberEngine<Wrapper<long long> >(graph);
+    return new CaliberEngine<Wrapper<int> >(graph);
+  }
+  if (wideKeys)
+    return new HeapEngine<Wrapper<long long> >(graph);
+  return new HeapEngine<Wrapper<int> >(graph);
+}
+
+SPEngine *spNewEngine(int type, int mode, CSRGraph *graph, Node *nodes,
+		      SPParams *params)
+{
+  switch (type) {
+  case SP_DIK_FIBHEAP:
+    return heapEngine<FiboHeap_Wrapper>(type, mode, graph, params);
+  case SP_DIK_BINHEAP:
+    return heapEngine<BinoHeap_Wrapper>(type, mode, graph, params);
+  case SP_DIK_RADIX:
+    return heapEngine<RadixHeap_Wrapper>(type, mode, graph, params);
+  case SP_DIK_DARY2:
+    return heapEngine<Dary2Heap_Wrapper>(type, mode, graph, params);
+  case SP_DIK_DARY4:
+    return heapEngine<Dary4Heap_Wrapper>(type, mode, graph, params);
+  case SP_DIK_DARY8:
+    return heapEngine<Dary8Heap_Wrapper>(type, mode, graph, params);
+  case SP_DIK_PAIRING:
+    return heapEngine<PairHeap_Wrapper>(type, mode, graph, params);
+  }
+
+  // bucket-based backends: one-to-all (and single pair) only
+  if (params->caliber) {
+    fprintf(stderr, "ERROR: calibers are an option for the heaps only\n");
+    exit(1);
+  }
+  if (mode == SP_MODE_SS || mode == SP_MODE_P2P) {
+    switch (type) {
+    case SP_DIK_SMARTQ:
+      return new SmartQEngine<false>(graph, nodes, params->levels,
+				     params->logDelta);
+    case SP_DIK_MLB:
+      return new SmartQEngine<true>(graph, nodes, params->levels,
+				    params->logDelta);
+    case SP_DIK_DELTA:
+      if (mode == SP_MODE_SS)
+	return new DeltaEngine(graph, params->threads, params->logDelta);
+      break;
+    case SP_DIK_DIAL:
+      return new DialEngine(graph);
+    }
+  }
+  fprintf(stderr, "ERROR: queue type %d does not support mode %s\n",
+	  type, spModeName(mode));
+  exit(1);
+}
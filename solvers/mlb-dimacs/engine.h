@@ -0,0 +1,95 @@
+// engine.h
+//     An SPEngine is one queue backend set up for one search mode.
+//     SP owns exactly one, picked by name at run time from the
+//     registry in engine.cc.  The search loop inside each engine is
+//     a template instance, so choosing a backend costs one virtual
+//     call per query and nothing per scanned arc.
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "nodearc.h"
+#include "csr.h"
+
+#ifndef ulong
+typedef unsigned long ulong; // to get that extra bit
+#endif
+
+class SP;                // defined in sp.h
+
+#define SP_DIK_FIBHEAP      1          // queue backends; see spQueues[]
+#define SP_DIK_BINHEAP      2
+#define SP_DIK_SMARTQ       3
+#define SP_DIK_MLB          4
+#define SP_DIK_DELTA        5
+#define SP_DIK_RADIX        6
+#define SP_DIK_DARY2        7
+#define SP_DIK_DARY4        8
+#define SP_DIK_DARY8        9
+#define SP_DIK_PAIRING      10
+#define SP_DIK_DIAL         11
+
+#define SP_DEFAULT_QUEUE    "binomial" // unless spAutoQueue() finds better
+
+#define SP_MODE_SS          1          // one-to-all from each source
+#define SP_MODE_P2P         2          // source to sink
+#define SP_MODE_BIDIR       3          // source to sink, bidirectional
+#define SP_MODE_ASTAR       4          // source to sink, A* on coordinates
+#define SP_MODE_ALT         5          // source to sink, A* on landmarks
+#define SP_MODE_CH          6          // source to sink, Contraction Hierarchies
+#define SP_MODE_ARCFLAGS    7          // source to sink, arc-flags
+
+class SPEngine {
+ public:
+   virtual ~SPEngine() {}
+   // sink is NULL for one-to-all; returns false if sink is unreachable
+   virtual bool run(Node *source, Node *sink, SP *sp) = 0;
+   virtual void PrintStats(long) {}
+   // a new engine of the same kind searching the labels in nodes;
+   // preprocessed data is shared, read-only, with this one
+   virtual SPEngine *Clone(Node *nodes) = 0;
+};
+
+typedef struct SPQueueInfo {
+   const char *name;     // as given to --queue=
+   int type;             // SP_DIK_*
+   const char *desc;     // for the run header
+   int modes;            // bit (1 << SP_MODE_*) set for supported modes
+} SPQueueInfo;
+
+// everything an engine may need besides the graph; see spDefaultParams()
+typedef struct SPParams {
+   ulong levels;         // smartq/mlb: number of bucket levels, or 0
+   ulong logDelta;       // smartq/mlb: log of the bucket width, or 0
+   bool wideKeys;        // heaps: 64-bit rather than 32-bit keys
+   bool caliber;         // heaps, ss and p2p: settle nodes within their
+                         // caliber of the minimum without the heap
+                         // (caliber.h)
+   int altMethod;        // alt: ALT_* landmark selection (alt.h), or 0
+                         // to read the tables from altFile
+   int altCount;         // alt: number of landmarks to select
+   const char *altFile;  // alt: tables to read, or to write once selected
+   bool chContract;      // ch: build the hierarchy rather than read it
+   const char *chFile;   // ch: hierarchy to read, or to write once built
+   int afMethod;         // arcflags: AF_* partition method (arcflags.h),
+                         // or 0 to read the flags from afFile
+   int afCells;          // arcflags: number of cells
+   const char *afFile;   // arcflags: flags to read, or to write once built
+   int threads;          // threads for preprocessing
+} SPParams;
+
+void spDefaultParams(SPParams *params);
+
+extern SPQueueInfo spQueues[];         // terminated by a NULL name
+
+SPQueueInfo *spFindQueue(const char *name);
+// the queue to use when none is named: dial for ss and p2p on
+// graphs with short arcs, SP_DEFAULT_QUEUE otherwise
+SPQueueInfo *spAutoQueue(CSRGraph *graph, int mode);
+const char *spModeName(int mode);
+int spFindMode(const char *name);      // 0 if unknown
+
+SPEngine *spNewEngine(int type, int mode, CSRGraph *graph, Node *nodes,
+		      SPParams *params);
+
+#endif
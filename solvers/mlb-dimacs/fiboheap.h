@@ -3,35 +3,38 @@
 
 #include "fiboheap_core.h"
 #include "nodearc.h"
+#include "csr.h"
 #include "sp.h" //get shortest path wrapper class
 
 #ifndef ulong
 typedef unsigned long ulong; // to get that extra bit
 #endif
 
-typedef struct FibArc;
-
-typedef FibNode<FibArc*> FiboNode;
-
-//with a dummy head, arc use only in fiboheap.
-typedef struct FibArc{
-    long long len;  //len of arc
-    FiboNode *head; //the conjunctive node
-    FibArc *next;   //NULL if no other edge
-} ;
-
+//a heap node only carries the index of its graph node in the CSR graph.
+//KeyType is int or long long, chosen by the driver from the largest
+//possible distance; instantiations live in fiboheap.cc.
+template <class KeyType>
 class FiboHeap_Wrapper{
+public:
+    typedef FibNode<long, KeyType> FiboNode;
 private:
-    FibHeap<FibArc *> * instance;
-    void initHeap(ulong N, Node *nodes);
+    FibHeap<long, KeyType> * instance;
+    CSRGraph *graph;  //shared, read-only
+    FiboNode *pool;   //pool[v] is the heap node of graph node v
 public:
-    FiboHeap_Wrapper(ulong N,Node *nodes);
+    FiboHeap_Wrapper(CSRGraph *graph);
 
     ~FiboHeap_Wrapper();
-    void dijkstra(Node *source, SP *sp);
     FiboNode *RemoveMin();
-    void reInit(ulong N, Node *nodes);
-    void printfStats();
+
+    //queue interface the searches run on (HeapEngine in engine.cc,
+    //bidir.h and the others); v is a node index, keys are distances
+    void Clear();
+    void Push(long v, long long key);
+    void Decrease(long v, long long key);
+    long PopMin();             //-1 if empty
+    long long MinKey();        //must not be empty
+    bool IsEmpty();
 };
 
 #endif
@@ -9,47 +9,48 @@
 
 #define nullptr NULL
 
-template <class ElementType>
+// KeyType is the priority type; pick the narrowest type that holds
+// every key the heap will see.
+template <class ElementType, class KeyType = int>
 struct FibNode
 {
     ElementType element; // element data
-    bool visited; // whether visited
-    int key; // key value
-    int degree; // number of children
-    FibNode<ElementType>* left; // left sibling ptr
-    FibNode<ElementType>* right; // right sibling ptr
-    FibNode<ElementType>* child; // first child ptr
-    FibNode<ElementType>* parent; // parent ptr
+    KeyType key; // key value
+    short degree; // number of children, at most log_phi(n)
     bool mark; // whether one of children has been deleted when parent remains same
+    FibNode<ElementType, KeyType>* left; // left sibling ptr
+    FibNode<ElementType, KeyType>* right; // right sibling ptr
+    FibNode<ElementType, KeyType>* child; // first child ptr
+    FibNode<ElementType, KeyType>* parent; // parent ptr
 
     // Constructor.
-    FibNode(ElementType element, int key);
+    FibNode(ElementType element, KeyType key);
     FibNode();
     // Destructor.
     ~FibNode();
 };
 
-template<class ElementType>
+template <class ElementType, class KeyType = int>
 class FibHeap {
 private:
     int m_size; // number of nodes
     int m_maxDegree; // max degree of trees
-    FibNode<ElementType>** m_cons; // ptr array, temporary space for consolidation
+    FibNode<ElementType, KeyType>** m_cons; // ptr array, temporary space for consolidation
 
     // Remove node from its siblings.
-    void RemoveNode(FibNode<ElementType>* node);
+    void RemoveNode(FibNode<ElementType, KeyType>* node);
 
     // Add node to root's left.
-    void AddNode(FibNode<ElementType>* node, FibNode<ElementType>* root);
+    void AddNode(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* root);
 
     // Catenate successor to predessor's right.
-    void CatList(FibNode<ElementType>* predecessor, FibNode<ElementType>* successor);
+    void CatList(FibNode<ElementType, KeyType>* predecessor, FibNode<ElementType, KeyType>* successor);
 
     // Remove min tree from heap and return it.
-    FibNode<ElementType>* ExtractMin();
+    FibNode<ElementType, KeyType>* ExtractMin();
 
     // Make node a child of root.
-    void MakeChild(FibNode<ElementType>* node, FibNode<ElementType>* root);
+    void MakeChild(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* root);
 
     // Alloc space for consolidation.
     void AllocCons();
@@ -58,42 +59,42 @@ private:
     void Consolidate();
 
     // Decrease parent's and all ancestors' degree by subtrahend.
-    void DecreaseDegree(FibNode<ElementType>* node, int subtrahend);
+    void DecreaseDegree(FibNode<ElementType, KeyType>* node, int subtrahend);
 
     // Cut node from its tree and insert it into forest.
-    void Cut(FibNode<ElementType>* node, FibNode<ElementType>* parent);
+    void Cut(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* parent);
 
     // Cascading cut node:
     // If node is marked, cut it and cascading cut its parent.
     // If not, mark it.
-    void CascadingCut(FibNode<ElementType>* node);
+    void CascadingCut(FibNode<ElementType, KeyType>* node);
 
-    // Increase node's key to "int key".
-    void Increase(FibNode<ElementType>* node, int key);
+    // Increase node's key to "KeyType key".
+    void Increase(FibNode<ElementType, KeyType>* node, KeyType key);
 
-    // Update node's key to "int key".
-    void Update(FibNode<ElementType>* node, int key);
+    // Update node's key to "KeyType key".
+    void Update(FibNode<ElementType, KeyType>* node, KeyType key);
 
-    // Find node of key "int key" in tree T and return it.
-    FibNode<ElementType>* FindKey(FibNode<ElementType>* T, int key);
+    // Find node of key "KeyType key" in tree T and return it.
+    FibNode<ElementType, KeyType>* FindKey(FibNode<ElementType, KeyType>* T, KeyType key);
 
     // Find node of element "ElementType element" in tree T and its siblings and return it.
-    FibNode<ElementType>* FindElement(FibNode<ElementType>* T, ElementType element);
+    FibNode<ElementType, KeyType>* FindElement(FibNode<ElementType, KeyType>* T, ElementType element);
 
     // Remove node.
-    void Remove(FibNode<ElementType>* node);
+    void Remove(FibNode<ElementType, KeyType>* node);
 
     // Print node and all its siblings and children.
     // If flag = true, node is a first child.
     // If flag = false, node is a sibling.
-    void Print(FibNode<ElementType>* node, FibNode<ElementType>* prev, bool flag);
+    void Print(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* prev, bool flag);
 
     // Destroy node.
-    void DestroyNode(FibNode<ElementType>* node);
+    void DestroyNode(FibNode<ElementType, KeyType>* node);
 
 public:
 
-    FibNode<ElementType>* m_min; // ptr to tree with root of min key
+    FibNode<ElementType, KeyType>* m_min; // ptr to tree with root of min key
     // Constructor.
     FibHeap();
 
@@ -101,41 +102,44 @@ public:
     ~FibHeap();
 
     // Insert node into FibHeap.
-    void Insert(FibNode<ElementType>* node);
+    void Insert(FibNode<ElementType, KeyType>* node);
     
-    // Decrease node's key to "int key".
-    void Decrease(FibNode<ElementType>* node, int key);
+    // Decrease node's key to "KeyType key".
+    void Decrease(FibNode<ElementType, KeyType>* node, KeyType key);
 
     // Insert a new node initialized by element and key into heap.
-    void Insert(ElementType element, int key);
+    void Insert(ElementType element, KeyType key);
 
     // Remove min node.
     void RemoveMin();
 
     // Combine two fibheaps.
-    void Combine(FibHeap<ElementType>* fibheap);
+    void Combine(FibHeap<ElementType, KeyType>* fibheap);
 
     // Get min tree.
-    FibNode<ElementType>* GetMin();
+    FibNode<ElementType, KeyType>* GetMin();
 
-    // Find node of key "int key" in heap.
-    FibNode<ElementType>* FindKey(int key);
+    // Find node of key "KeyType key" in heap.
+    FibNode<ElementType, KeyType>* FindKey(KeyType key);
 
     // Find node of element "ElementType" in heap.
-    FibNode<ElementType>* FindElement(ElementType element);
+    FibNode<ElementType, KeyType>* FindElement(ElementType element);
 
     // Find node of key oldKey and then update it to newKey.
-    void Update(int oldKey, int newKey);
+    void Update(KeyType oldKey, KeyType newKey);
 
-    // Remove node of key "int key".
-    void Remove(int key);
+    // Remove node of key "KeyType key".
+    void Remove(KeyType key);
 
-    // Return whether there exists a node of key "int key".
-    bool Contains(int key);
+    // Return whether there exists a node of key "KeyType key".
+    bool Contains(KeyType key);
 
     // Print heap.
     void Print();
 
+    // Empty the heap in O(1); nodes still linked are simply dropped.
+    void Clear();
+
     // Destroy heap.
     void Destroy();
 };
@@ -143,31 +147,31 @@ public:
 // struct FibNode<class ElementType>
 
 // Constructor.
-template<class ElementType>
-FibNode<ElementType>::FibNode(ElementType element, int key) : element(element), key(key), degree(0), mark(false), left(this), right(this), child(nullptr), parent(nullptr) {}
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>::FibNode(ElementType element, KeyType key) : element(element), key(key), degree(0), mark(false), left(this), right(this), child(nullptr), parent(nullptr) {}
 
-template<class ElementType>
-FibNode<ElementType>::FibNode() : degree(0), mark(false), left(this), right(this), child(nullptr), parent(nullptr) {}
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>::FibNode() : degree(0), mark(false), left(this), right(this), child(nullptr), parent(nullptr) {}
 
 // Destructor.
-template<class ElementType>
-FibNode<ElementType>::~FibNode() {}
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>::~FibNode() {}
 
 // class FibHeap<class ElementType>
 
 // Private:
 
 // Remove node from its siblings.
-template <class ElementType>
-void FibHeap<ElementType>::RemoveNode(FibNode<ElementType>* node)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::RemoveNode(FibNode<ElementType, KeyType>* node)
 {
     node->left->right = node->right;
     node->right->left = node->left;
 }
 
 // Add node to root's left.
-template <class ElementType>
-void FibHeap<ElementType>::AddNode(FibNode<ElementType>* node, FibNode<ElementType>* root)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::AddNode(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* root)
 {
     node->left = root->left;
     root->left->right = node;
@@ -177,10 +181,10 @@ void FibHeap<ElementType>::AddNode(FibNode<ElementType>* node, FibNode<ElementTy
 
 // Catenate successor to predecessor's right.
 // Both predecessor and successor are double-linked list.
-template <class ElementType>
-void FibHeap<ElementType>::CatList(FibNode<ElementType>* predecessor, FibNode<ElementType>* successor)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::CatList(FibNode<ElementType, KeyType>* predecessor, FibNode<ElementType, KeyType>* successor)
 {
-    FibNode<ElementType>* temp;
+    FibNode<ElementType, KeyType>* temp;
     temp = predecessor->right;
     predecessor->right = successor->right;
     successor->right->left = predecessor;
@@ -189,8 +193,8 @@ void FibHeap<ElementType>::CatList(FibNode<ElementType>* predecessor, FibNode<El
 }
 
 // Insert node into FibHeap.
-template <class ElementType>
-void FibHeap<ElementType>::Insert(FibNode<ElementType>* node)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Insert(FibNode<ElementType, KeyType>* node)
 {
     if (m_size == 0)
         m_min = node;
@@ -204,11 +208,11 @@ void FibHeap<ElementType>::Insert(FibNode<ElementType>* node)
 }
 
 // Remove min tree from heap and return it.
-template <class ElementType>
-FibNode<ElementType>* FibHeap<ElementType>::ExtractMin()
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>* FibHeap<ElementType, KeyType>::ExtractMin()
 {
     // Get root T of min tree.
-    FibNode<ElementType>* T = m_min;
+    FibNode<ElementType, KeyType>* T = m_min;
 
     // If T is the last tree, update min tree to nullptr.
     if (T == T->right)
@@ -225,8 +229,8 @@ FibNode<ElementType>* FibHeap<ElementType>::ExtractMin()
 }
 
 // Make node a child of root.
-template <class ElementType>
-void FibHeap<ElementType>::MakeChild(FibNode<ElementType>* node, FibNode<ElementType>* root)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::MakeChild(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* root)
 {
     // Remove node from its siblings.
     RemoveNode(node);
@@ -246,23 +250,24 @@ void FibHeap<ElementType>::MakeChild(FibNode<ElementType>* node, FibNode<Element
 }
 
 // Alloc space for consolidation.
-template <class ElementType>
-void FibHeap<ElementType>::AllocCons()
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::AllocCons()
 {
     // Update max degree and decide whether reallocation is needed.
     int old = m_maxDegree;
-    m_maxDegree = static_cast<int>(log(m_size) / log(2.0)) + 1; // "+1" for rounding up
+    // A tree of degree d holds at least F(d+2) >= phi^d nodes.
+    m_maxDegree = static_cast<int>(log(m_size) / log(1.618)) + 1; // "+1" for rounding up
 
     // If not needed, return.
     if (old >= m_maxDegree)
         return;
     // If is, realloc.
-    m_cons = (FibNode<ElementType>**)realloc(m_cons, sizeof(FibHeap<ElementType>*) * (m_maxDegree + 1)); // "+1" for extra space
+    m_cons = (FibNode<ElementType, KeyType>**)realloc(m_cons, sizeof(FibHeap<ElementType, KeyType>*) * (m_maxDegree + 1)); // "+1" for extra space
 }
 
 // Consolidate trees with same degree.
-template <class ElementType>
-void FibHeap<ElementType>::Consolidate()
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Consolidate()
 {
     // Alloc space for consolidation.
     AllocCons();
@@ -274,14 +279,14 @@ void FibHeap<ElementType>::Consolidate()
     // Consolidate trees with same degree into the ptr array.
     while (m_min != nullptr)
     {
-        FibNode<ElementType>* x = ExtractMin(); // min tree
+        FibNode<ElementType, KeyType>* x = ExtractMin(); // min tree
         int d = x->degree; // degree of min tree
 
         // Consolidate all trees of same degree with min tree.
         while (m_cons[d] != nullptr)
         {
             // Find such tree.
-            FibNode<ElementType>* y = m_cons[d];
+            FibNode<ElementType, KeyType>* y = m_cons[d];
 
             // Make the one with bigger key a child of the one with smaller key.
             if (x->key > y->key)
@@ -316,8 +321,8 @@ void FibHeap<ElementType>::Consolidate()
 }
 
 // Decrease node's and all ancestors' degree by subtrahend.
-template <class ElementType>
-void FibHeap<ElementType>::DecreaseDegree(FibNode<ElementType>* node, int subtrahend)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::DecreaseDegree(FibNode<ElementType, KeyType>* node, int subtrahend)
 {
     node->degree -= subtrahend;
     if (node->parent != nullptr)
@@ -325,14 +330,14 @@ void FibHeap<ElementType>::DecreaseDegree(FibNode<ElementType>* node, int subtra
 }
 
 // Cut node from its tree and add it into forest.
-template <class ElementType>
-void FibHeap<ElementType>::Cut(FibNode<ElementType>* node, FibNode<ElementType>* parent)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Cut(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* parent)
 {
     // Remove node from its siblings.
     RemoveNode(node);
 
-    // Update ancestor's degrees.
-    DecreaseDegree(parent, node->degree);
+    // Parent loses one child.
+    parent->degree--;
 
     // Update parent's children.
     if (node == node->right)
@@ -353,10 +358,10 @@ void FibHeap<ElementType>::Cut(FibNode<ElementType>* node, FibNode<ElementType>*
 // Cascading cut node:
 // If node is marked, cut it and cascading cut its parent.
 // If not, mark it.
-template <class ElementType>
-void FibHeap<ElementType>::CascadingCut(FibNode<ElementType>* node)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::CascadingCut(FibNode<ElementType, KeyType>* node)
 {
-    FibNode<ElementType>* parent = node->parent;
+    FibNode<ElementType, KeyType>* parent = node->parent;
     if (parent != nullptr)
     {
         // If node is marked, cut it and cascading cut its parent.
@@ -371,11 +376,11 @@ void FibHeap<ElementType>::CascadingCut(FibNode<ElementType>* node)
     }
 }
 
-// Decrease node's key to "int key".
-template <class ElementType>
-void FibHeap<ElementType>::Decrease(FibNode<ElementType>* node, int key)
+// Decrease node's key to "KeyType key".
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Decrease(FibNode<ElementType, KeyType>* node, KeyType key)
 {
-    FibNode<ElementType>* parent = node->parent;
+    FibNode<ElementType, KeyType>* parent = node->parent;
 
     // If decrease fails, return.
     if (m_min == nullptr || node == nullptr || key >= node->key)
@@ -396,11 +401,11 @@ void FibHeap<ElementType>::Decrease(FibNode<ElementType>* node, int key)
         m_min = node;
 }
 
-// Increase node's key to "int key".
-template <class ElementType>
-void FibHeap<ElementType>::Increase(FibNode<ElementType>* node, int key)
+// Increase node's key to "KeyType key".
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Increase(FibNode<ElementType, KeyType>* node, KeyType key)
 {
-    FibNode<ElementType>* child, * parent, * right;
+    FibNode<ElementType, KeyType>* child, * parent, * right;
 
     // If increase fails, return.
     if (m_min == nullptr || node == nullptr || key <= node->key)
@@ -445,9 +450,9 @@ void FibHeap<ElementType>::Increase(FibNode<ElementType>* node, int key)
     }
 }
 
-// Update node's key to "int key".
-template <class ElementType>
-void FibHeap<ElementType>::Update(FibNode<ElementType>* node, int key)
+// Update node's key to "KeyType key".
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Update(FibNode<ElementType, KeyType>* node, KeyType key)
 {
     if (key < node->key)
         Decrease(node, key);
@@ -455,12 +460,12 @@ void FibHeap<ElementType>::Update(FibNode<ElementType>* node, int key)
         Increase(node, key);
 }
 
-// Find node of key "int key" in tree T and its siblings and return it.
-template <class ElementType>
-FibNode<ElementType>* FibHeap<ElementType>::FindKey(FibNode<ElementType>* T, int key)
+// Find node of key "KeyType key" in tree T and its siblings and return it.
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>* FibHeap<ElementType, KeyType>::FindKey(FibNode<ElementType, KeyType>* T, KeyType key)
 {
-    FibNode<ElementType>* cur = T; // current
-    FibNode<ElementType>* res = nullptr; // result
+    FibNode<ElementType, KeyType>* cur = T; // current
+    FibNode<ElementType, KeyType>* res = nullptr; // result
 
     // If tree is nullptr, return nullptr.
     if (T == nullptr)
@@ -484,9 +489,9 @@ FibNode<ElementType>* FibHeap<ElementType>::FindKey(FibNode<ElementType>* T, int
     return res;
 }
 
-// Find node of key "int key" in heap.
-template <class ElementType>
-FibNode<ElementType>* FibHeap<ElementType>::FindKey(int key)
+// Find node of key "KeyType key" in heap.
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>* FibHeap<ElementType, KeyType>::FindKey(KeyType key)
 {
     if (m_min == nullptr)
         return nullptr;
@@ -495,11 +500,11 @@ FibNode<ElementType>* FibHeap<ElementType>::FindKey(int key)
 }
 
 // Find node of element "ElementType element" in tree T and its siblings and return it.
-template <class ElementType>
-FibNode<ElementType>* FibHeap<ElementType>::FindElement(FibNode<ElementType>* T, ElementType element)
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>* FibHeap<ElementType, KeyType>::FindElement(FibNode<ElementType, KeyType>* T, ElementType element)
 {
-    FibNode<ElementType>* cur = T; // current
-    FibNode<ElementType>* res = nullptr; // result
+    FibNode<ElementType, KeyType>* cur = T; // current
+    FibNode<ElementType, KeyType>* res = nullptr; // result
 
     // If tree is nullptr, return nullptr.
     if (T == nullptr)
@@ -525,8 +530,8 @@ FibNode<ElementType>* FibHeap<ElementType>::FindElement(FibNode<ElementType>* T,
 }
 
 // Find node of element "ElementType" in heap.
-template <class ElementType>
-FibNode<ElementType>* FibHeap<ElementType>::FindElement(ElementType element)
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>* FibHeap<ElementType, KeyType>::FindElement(ElementType element)
 {
     if (m_min == nullptr)
         return nullptr;
@@ -535,10 +540,10 @@ FibNode<ElementType>* FibHeap<ElementType>::FindElement(ElementType element)
 }
 
 // Remove node from heap.
-template <class ElementType>
-void FibHeap<ElementType>::Remove(FibNode<ElementType>* node)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Remove(FibNode<ElementType, KeyType>* node)
 {
-    int m = m_min->key - 1;
+    KeyType m = m_min->key - 1;
     Decrease(node, m - 1);
     RemoveMin();
 }
@@ -546,10 +551,10 @@ void FibHeap<ElementType>::Remove(FibNode<ElementType>* node)
 // Print node and all its siblings and children.
 // If flag = true, node is a first child.
 // If flag = false, node is a sibling.
-template <class ElementType>
-void FibHeap<ElementType>::Print(FibNode<ElementType>* node, FibNode<ElementType>* pred, bool flag)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Print(FibNode<ElementType, KeyType>* node, FibNode<ElementType, KeyType>* pred, bool flag)
 {
-    FibNode<ElementType>* start = node;
+    FibNode<ElementType, KeyType>* start = node;
 
     if (node == nullptr)
         return;
@@ -574,10 +579,10 @@ void FibHeap<ElementType>::Print(FibNode<ElementType>* node, FibNode<ElementType
 }
 
 // Destroy node.
-template <class ElementType>
-void FibHeap<ElementType>::DestroyNode(FibNode<ElementType>* node)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::DestroyNode(FibNode<ElementType, KeyType>* node)
 {
-    FibNode<ElementType>* start = node;
+    FibNode<ElementType, KeyType>* start = node;
 
     if (node == nullptr)
         return;
@@ -595,27 +600,27 @@ void FibHeap<ElementType>::DestroyNode(FibNode<ElementType>* node)
 // Public:
 
 // Constructor.
-template <class ElementType>
-FibHeap<ElementType>::FibHeap() : m_size(0), m_maxDegree(0), m_min(nullptr), m_cons(nullptr) {}
+template <class ElementType, class KeyType>
+FibHeap<ElementType, KeyType>::FibHeap() : m_size(0), m_maxDegree(0), m_cons(nullptr), m_min(nullptr) {}
 
 // Destructor.
-template <class ElementType>
-FibHeap<ElementType>::~FibHeap() {}
+template <class ElementType, class KeyType>
+FibHeap<ElementType, KeyType>::~FibHeap() {}
 
 // Initialize a new node by element and key, then insert it into heap.
-template <class ElementType>
-void FibHeap<ElementType>::Insert(ElementType element, int key)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Insert(ElementType element, KeyType key)
 {
-    FibNode<ElementType>* node = new FibNode<ElementType>(element, key);
+    FibNode<ElementType, KeyType>* node = new FibNode<ElementType, KeyType>(element, key);
     Insert(node);
 }
 
 // Remove min node.
-template <class ElementType>
-void FibHeap<ElementType>::RemoveMin()
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::RemoveMin()
 {
-    FibNode<ElementType>* child = nullptr;
-    FibNode<ElementType>* m = m_min;
+    FibNode<ElementType, KeyType>* child = nullptr;
+    FibNode<ElementType, KeyType>* m = m_min;
 
     if (m_min == nullptr)
         return;
@@ -651,8 +656,8 @@ void FibHeap<ElementType>::RemoveMin()
 }
 
 // Combine two fibheaps.
-template <class ElementType>
-void FibHeap<ElementType>::Combine(FibHeap<ElementType>* fibheap)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Combine(FibHeap<ElementType, KeyType>* fibheap)
 {
     // If fibheap is nullptr, do nothing.
     if (fibheap == nullptr)
@@ -694,28 +699,28 @@ void FibHeap<ElementType>::Combine(FibHeap<ElementType>* fibheap)
 }
 
 // Get min tree.
-template <class ElementType>
-FibNode<ElementType>* FibHeap<ElementType>::GetMin()
+template <class ElementType, class KeyType>
+FibNode<ElementType, KeyType>* FibHeap<ElementType, KeyType>::GetMin()
 {
     return m_min;
 }
 
 // Find node of key oldKey and then update it to newKey.
-template <class ElementType>
-void FibHeap<ElementType>::Update(int oldKey, int newKey)
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Update(KeyType oldKey, KeyType newKey)
 {
-    FibNode<ElementType>* node;
+    FibNode<ElementType, KeyType>* node;
 
     node = FindKey(oldKey);
     if (node != nullptr)
         Update(node, newKey);
 }
 
-// Remove node of key "int key".
-template <class ElementType>
-void FibHeap<ElementType>::Remove(int key)
+// Remove node of key "KeyType key".
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Remove(KeyType key)
 {
-    FibNode<ElementType>* node;
+    FibNode<ElementType, KeyType>* node;
 
     if (m_min == nullptr)
         return;
@@ -727,19 +732,19 @@ void FibHeap<ElementType>::Remove(int key)
     Remove(node);
 }
 
-// Return whether there exists a node of key "int key".
-template <class ElementType>
-bool FibHeap<ElementType>::Contains(int key)
+// Return whether there exists a node of key "KeyType key".
+template <class ElementType, class KeyType>
+bool FibHeap<ElementType, KeyType>::Contains(KeyType key)
 {
     return FindKey(key) != nullptr ? true : false;
 }
 
 // Print heap.
-template <class ElementType>
-void FibHeap<ElementType>::Print()
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Print()
 {
     int i = 0;
-    FibNode<ElementType>* p;
+    FibNode<ElementType, KeyType>* p;
 
     if (m_min == nullptr)
         return;
@@ -756,12 +761,20 @@ void FibHeap<ElementType>::Print()
     std::cout << std::endl;
 }
 
+// Empty the heap.  Callers reinitialize a node before inserting it again.
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Clear()
+{
+    m_min = nullptr;
+    m_size = 0;
+}
+
 // Destroy heap.
-template <class ElementType>
-void FibHeap<ElementType>::Destroy()
+template <class ElementType, class KeyType>
+void FibHeap<ElementType, KeyType>::Destroy()
 {
     //DestroyNode(m_min);
     free(m_cons);
 }
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
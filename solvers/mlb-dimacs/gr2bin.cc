@@ -0,0 +1,57 @@
+/* gr2bin.cc
+ *     Converts a DIMACS graph, and optionally its node coordinates,
+ *     into a binary graph file (csr.h) that sp.exe and splib map
+ *     instead of parsing:
+ *
+ *       gr2bin.exe [--threads=<n>] [--co=<file>] <graph file> <binary file>
+ *
+ *     --threads is passed on to the parser.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "csr.h"
+
+extern int parse_gr_threads( long *n_ad, long *m_ad, CSRGraph **graph_ad,
+			     char *problem_name, int threads );
+extern int parse_co(long nGraph, long **x_array, long **y_array, char *coName);
+
+static void usage(char *prog)
+{
+  fprintf(stderr,
+	  "Usage: \"%s [--threads=<n>] [--co=<file>] <graph file> <binary file>\"\n",
+	  prog);
+  exit(0);
+}
+
+int main(int argc, char **argv)
+{
+  CSRGraph *graph;
+  long n, m;
+  char *args[2], *coName = NULL;
+  int nArgs = 0, threads = 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--threads=", 10) == 0)
+      threads = atoi(argv[i] + 10);
+    else if (strncmp(argv[i], "--co=", 5) == 0)
+      coName = argv[i] + 5;
+    else if (strncmp(argv[i], "--", 2) == 0 || nArgs == 2)
+      usage(argv[0]);
+    else
+      args[nArgs++] = argv[i];
+  }
+  if (nArgs < 2)
+    usage(argv[0]);
+
+  parse_gr_threads(&n, &m, &graph, args[0], threads);
+  if (coName != NULL)
+    parse_co(n, &graph->x, &graph->y, coName);
+
+  csr_write_bin(graph, args[1]);
+  fprintf(stderr, "c %s: %ld nodes, %ld arcs%s\n", args[1], n, m,
+	  coName != NULL ? ", coordinates" : "");
+  csr_free(graph);
+  return 0;
+}
@@ -1,95 +1,341 @@
 /* main.cc  by Andrew Goldberg
- *     Driver for all the sp algorithms.
+ *     Driver for all the sp algorithms.  The queue backend and the
+ *     problem variant are chosen on the command line:
  *
+ *       --queue=<name>   one of the backends in spQueues[] (engine.cc);
+ *                        by default spAutoQueue() picks one from the
+ *                        arc lengths and the mode
+ *       --mode=ss|p2p|bidir
+ *                        single-source (.ss aux file) or point-to-point
+ *                        (.p2p aux file) problems; bidir answers the
+ *                        point-to-point ones with bidirectional search
+ *     The graph file is a .gr file or a binary graph file made by
+ *     gr2bin (csr.h), which is mapped instead of parsed.
+ *
+ *       --mode=astar     point-to-point problems by A* search; needs
+ *       --co=<file>      node coordinates (.co aux file, or those of a
+ *                        binary graph file), read as
+ *       --lonlat         longitude/latitude if given
+ *       --mode=alt       point-to-point problems by A* search with
+ *                        landmark lower bounds; the landmarks are
+ *       --landmarks=<file>  read from a file (alt.h), or
+ *       --select=avoid|farthest|planar  selected (and saved to the
+ *       --nlandmarks=<k>    file if one is given)
+ *       --mode=ch        point-to-point problems on a contraction
+ *                        hierarchy, read from
+ *       --hierarchy=<file>  a file (ch.h), or built with
+ *       --contract       (and saved to the file if one is given)
+ *       --mode=arcflags  point-to-point problems by search restricted
+ *                        to arcs flagged for the sink's cell; flags are
+ *       --arcflags=<file>  read from a file (arcflags.h), or computed
+ *       --partition=coords|grow  on a partition into
+ *       --cells=<k>         cells (and saved to the file if one is given)
+ *       --threads=<n>    threads for reading the graph, for
+ *                        preprocessing and for the problems, which are
+ *                        independent; results are printed in input
+ *                        order either way; with
+ *                        --queue=delta the threads share each search
+ *                        and the problems run one at a time
+ *       --caliber        with a heap, ss and p2p: nodes whose distance
+ *                        is within their caliber of the heap minimum
+ *                        skip the heap (caliber.h)
+ *       --widearcs       search the 16-byte arcs even when the graph
+ *                        fits the compact 8-byte ones (csr.h)
+ *       --reorder=bfs|rcm|hilbert
+ *                        renumber the nodes for locality (reorder.h)
+ *                        once loaded; problems are translated, so ids
+ *                        and results stay in the input numbering
+ *       --checksum       print a distance/checksum line per problem
+ *                        instead of the average time
  */
 
 #include <stdlib.h>       // for atoi
 #include <stdio.h>        // for printf
 #include "sp.h"           // shortest-path class
+#include "alt.h"          // for altFindMethod
+#include "arcflags.h"     // for afFindMethod
+#include "pool.h"         // for poolRun
+#include "dial.h"         // for DIAL_AUTO_MAX_LEN
+#include "reorder.h"      // for reorderGraph
 #include <string.h>
+#include <limits.h>       // for INT_MAX
 
 #define MODUL ((long long) 1 << 62)
 
 extern double timer();            // in timer.cc: tells time use
-extern int parse_gr( long *n_ad, long *m_ad, Node **nodes_ad, Arc **arcs_ad, 
-		  long *node_min_ad, char *problem_name );
-#ifdef SINGLE_PAIR
+extern double wallTimer();        // in timer.cc: tells elapsed time
+extern int parse_gr_threads( long *n_ad, long *m_ad, CSRGraph **graph_ad,
+			     char *problem_name, int threads );
 extern int parse_p2p(long *sN_ad, long **source_array, long **sink_array, char *aName);
-#else
 extern int parse_ss(long *sN_ad, long **source_array, char *aName);
-#endif
+extern int parse_co(long nGraph, long **x_array, long **y_array, char *coName);
 
-#define SZ_DIK_HEAP   "Dijkstra with Fibonacci Heap"
-#define SZ_DIK_MLB      "Dijkstra with Multi-Level Buckets"
 #define SZ_BFS          "Breadth-First Search"
 
+static void usage(char *prog)
+{
+  SPQueueInfo *q;
+
+  fprintf(stderr,
+	  "Usage: \"%s [options] <graph file> <aux file> <out file> [0]\"\n    or \"%s [options] <graph file> <aux file> <out file> [<levels>] \"\n    or \"%s [options] <graph file> <aux file> <out file> [-<log delta>] \"\n", prog, prog, prog);
+  fprintf(stderr, "Options:\n");
+  fprintf(stderr, "    --queue=<name>   queue backend (default dial for ss/p2p if\n"
+	  "                     MaxArcLen <= %d, else %s):\n",
+	  DIAL_AUTO_MAX_LEN, SP_DEFAULT_QUEUE);
+  for (q = spQueues; q->name != NULL; q++)
+    fprintf(stderr, "                       %-10s %s\n", q->name, q->desc);
+  fprintf(stderr, "    --mode=ss|p2p|bidir|astar|alt|ch|arcflags  problem variant (default ss)\n");
+  fprintf(stderr, "    --co=<file>      node coordinates, for astar, if not in a binary graph\n");
+  fprintf(stderr, "    --landmarks=<file>  landmark tables, for alt\n");
+  fprintf(stderr, "    --select=avoid|farthest|planar  select landmarks for alt\n");
+  fprintf(stderr, "    --nlandmarks=<k> number of landmarks to select (default 16)\n");
+  fprintf(stderr, "    --hierarchy=<file>  contraction hierarchy, for ch\n");
+  fprintf(stderr, "    --contract       build the hierarchy for ch\n");
+  fprintf(stderr, "    --arcflags=<file>  arc-flag file, for arcflags\n");
+  fprintf(stderr, "    --partition=coords|grow  partition for arcflags\n");
+  fprintf(stderr, "    --cells=<k>      number of cells (default 64)\n");
+  fprintf(stderr, "    --threads=<n>    threads for preprocessing and queries (default 1)\n");
+  fprintf(stderr, "    --lonlat         coordinates are longitude/latitude\n");
+  fprintf(stderr, "    --caliber        heaps, ss/p2p: settle nodes by caliber without the heap\n");
+  fprintf(stderr, "    --widearcs       don't use compact 32-bit arcs\n");
+  fprintf(stderr, "    --reorder=bfs|rcm|hilbert  renumber nodes for locality\n");
+  fprintf(stderr, "    --checksum       print distances/checksums, not times\n");
+  exit(0);
+}
+
+//-------------------------------------------------------------
+// Queries
+//     Each thread has its own SP (sharing the graph and any
+//     preprocessed data) and its own labels.  A query only writes
+//     its own result slot, so results come out in input order
+//     whatever thread ran them.
+//-------------------------------------------------------------
+
+typedef struct Queries {
+  SP **sp;               // per thread
+  Node **nodes;          // per thread
+  long n;
+  long *source_array;
+  long *sink_array;      // NULL for single-source problems
+  bool checksum;
+  long long *dist;       // distance or checksum of each query
+  bool *found;           // whether the sink was reached
+} Queries;
+
+// translates problem nodes, ids 1 .. n, to the reordered graph
+static void reorderQueries(long *a, long nQ, const long *newId, long n,
+			   const char *aName)
+{
+  for (long i = 0; i < nQ; i++) {
+    if (a[i] < 1 || a[i] > n) {
+      fprintf(stderr, "ERROR: aux file %s: node %ld out of range 1..%ld\n",
+	      aName, a[i], n);
+      exit(1);
+    }
+    a[i] = newId[a[i] - 1] + 1;
+  }
+}
+
+static void runQuery(long i, int thread, void *arg)
+{
+  Queries *q = (Queries *) arg;
+  SP *sp = q->sp[thread];
+  Node *nodes = q->nodes[thread], *source, *sink, *node;
+  long long dist;
+
+  source = nodes + q->source_array[i] - 1;
+  sp->initS(source);
+  if (q->sink_array) {
+    sink = nodes + q->sink_array[i] - 1;
+    sp->sp(source, sink);
+    q->found[i] = (sink->tStamp == source->tStamp);
+    q->dist[i] = sink->dist;
+  }
+  else {
+    sp->sp(source);
+    q->found[i] = true;
+    if (q->checksum) {
+      dist = source->dist;
+      for ( node = nodes; node < nodes + q->n; node++ )
+	if (node->tStamp == sp->curTime) {
+	  dist = (dist + (node->dist % MODUL)) % MODUL;
+	}
+      q->dist[i] = dist;
+    }
+  }
+}
 
 int main(int argc, char **argv)
 {
    double tm = 0.0;
-   Arc *arcs;
+   CSRGraph *graph;
    Node *nodes, *source = NULL;
-#ifdef SINGLE_PAIR
-   Node *sink = NULL;
-#endif
-   long n, m, nmin, nQ;
+   long n, m, nQ;
    long *source_array=NULL;
-#ifdef SINGLE_PAIR
    long *sink_array=NULL;
-#endif
-   char *szAlgorithm, gName[100], aName[100], oName[100];
+   const char *szAlgorithm;
+   char gName[100], aName[100], oName[100];
+   char *args[4];
+   int nArgs = 0;
    FILE *oFile;
    long long dist;
    double dDist;
    long long maxArcLen, minArcLen;
    SP *sp;
-   ulong cLevels;
-   ulong logDelta;
+   Queries queries;
+   double wall = 0.0;
+   int threads, t;
+   SPQueueInfo *queue = NULL;
+   const char *queueName = NULL;    // NULL: pick from the graph
+   int mode = SP_MODE_SS;
+   bool checksum = false;
+   char *coName = NULL;
+   bool lonLat = false;
+   SPParams params;
    long param;
    bool doBFS = false;
+   bool wideArcs = false;
+   int order = 0;                   // REORDER_*, 0 for the input order
+   long *newId = NULL;
+   CSRGraph *reordered;
+
+   spDefaultParams(&params);
+   for (int i = 1; i < argc; i++) {
+     if (strncmp(argv[i], "--queue=", 8) == 0)
+       queueName = argv[i] + 8;
+     else if (strncmp(argv[i], "--mode=", 7) == 0) {
+       mode = spFindMode(argv[i] + 7);
+       if (mode == 0) {
+	 fprintf(stderr, "ERROR: unknown mode %s\n", argv[i] + 7);
+	 usage(argv[0]);
+       }
+     }
+     else if (strcmp(argv[i], "--checksum") == 0)
+       checksum = true;
+     else if (strcmp(argv[i], "--caliber") == 0)
+       params.caliber = true;
+     else if (strcmp(argv[i], "--widearcs") == 0)
+       wideArcs = true;
+     else if (strncmp(argv[i], "--reorder=", 10) == 0) {
+       order = reorderFindMethod(argv[i] + 10);
+       if (order == 0) {
+	 fprintf(stderr, "ERROR: unknown node order %s\n", argv[i] + 10);
+	 usage(argv[0]);
+       }
+     }
+     else if (strncmp(argv[i], "--co=", 5) == 0)
+       coName = argv[i] + 5;
+     else if (strcmp(argv[i], "--lonlat") == 0)
+       lonLat = true;
+     else if (strncmp(argv[i], "--landmarks=", 12) == 0)
+       params.altFile = argv[i] + 12;
+     else if (strncmp(argv[i], "--select=", 9) == 0) {
+       params.altMethod = altFindMethod(argv[i] + 9);
+       if (params.altMethod == 0) {
+	 fprintf(stderr, "ERROR: unknown landmark selection %s\n", argv[i] + 9);
+	 usage(argv[0]);
+       }
+     }
+     else if (strncmp(argv[i], "--nlandmarks=", 13) == 0)
+       params.altCount = atoi(argv[i] + 13);
+     else if (strncmp(argv[i], "--hierarchy=", 12) == 0)
+       params.chFile = argv[i] + 12;
+     else if (strcmp(argv[i], "--contract") == 0)
+       params.chContract = true;
+     else if (strncmp(argv[i], "--arcflags=", 11) == 0)
+       params.afFile = argv[i] + 11;
+     else if (strncmp(argv[i], "--partition=", 12) == 0) {
+       params.afMethod = afFindMethod(argv[i] + 12);
+       if (params.afMethod == 0) {
+	 fprintf(stderr, "ERROR: unknown partition method %s\n", argv[i] + 12);
+	 usage(argv[0]);
+       }
+     }
+     else if (strncmp(argv[i], "--cells=", 8) == 0)
+       params.afCells = atoi(argv[i] + 8);
+     else if (strncmp(argv[i], "--threads=", 10) == 0)
+       params.threads = atoi(argv[i] + 10);
+     else if (strncmp(argv[i], "--", 2) == 0 || nArgs == 4)
+       usage(argv[0]);
+     else
+       args[nArgs++] = argv[i];
+   }
 
-#if (defined CHECKSUM) && (!defined SINGLE_PAIR)
-   Node *node;
-#endif
+   if (nArgs < 3)
+     usage(argv[0]);
 
-   if ((argc < 4) || (argc > 5)) {
-     fprintf(stderr, 
-	     "Usage: \"%s <graph file> <aux file> <out file> [0]\"\n    or \"%s <graph file> <aux file> <out file> [<levels>] \"\n    or \"%s <graph file> <aux file> <out file> [-<log delta>] \"\n", argv[0], argv[0], argv[0]);
-     exit(0);
+   if (queueName != NULL) {
+     queue = spFindQueue(queueName);
+     if (queue == NULL) {
+       fprintf(stderr, "ERROR: unknown queue %s\n", queueName);
+       usage(argv[0]);
+     }
+     if (!(queue->modes & (1 << mode))) {
+       fprintf(stderr, "ERROR: queue %s does not support mode %s\n",
+	       queue->name, spModeName(mode));
+       exit(1);
+     }
    }
 
-   strcpy(gName, argv[1]);
-   strcpy(aName, argv[2]);
-   strcpy(oName, argv[3]);
+   strcpy(gName, args[0]);
+   strcpy(aName, args[1]);
+   strcpy(oName, args[2]);
    oFile = fopen(oName, "a");
 
    fprintf(stderr,"c ---------------------------------------------------\n");
    fprintf(stderr,"c SQ/SQP DIMACS Challenge version \n");
    fprintf(stderr,"c ---------------------------------------------------\n");
 
-   parse_gr(&n, &m, &nodes, &arcs, &nmin, gName ); 
-
-#ifdef SINGLE_PAIR
-#ifdef MLB
-   printf("p res p2p q mbp\n");
-#else
-   printf("p res p2p q sqp\n");
-#endif
-   parse_p2p(&nQ, &source_array, &sink_array, aName);
-#else
-#ifdef MLB
-   printf("p res ss mb\n");
-#else
-   printf("p res ss sq\n");
-#endif
-   parse_ss(&nQ, &source_array, aName);
-#endif
+   if (csr_is_bin(gName)) {
+     // a binary graph is used where it is mapped
+     graph = csr_map_bin(gName);
+     n = graph->n;
+     m = graph->m;
+   }
+   else
+     parse_gr_threads(&n, &m, &graph, gName, params.threads);
+   nodes = (Node *) calloc(n + 1, sizeof(Node));
+   if (nodes == NULL) {
+     fprintf(stderr, "ERROR: can't allocate labels\n");
+     exit(1);
+   }
+   if (coName != NULL)
+     parse_co(n, &graph->x, &graph->y, coName);
+   graph->lonLat = lonLat;
+   if (order != 0) {        // before anything is built on the graph
+     reordered = reorderGraph(graph, order, &newId, NULL);
+     csr_free(graph);
+     graph = reordered;
+   }
+   if (wideArcs)            // before the reverse, which then follows
+     csr_widen(graph);
+   else
+     csr_compact(graph);
+   if (mode == SP_MODE_BIDIR)
+     csr_add_reverse(graph);
+   if (queue == NULL)       // calibers need a heap
+     queue = params.caliber ? spFindQueue(SP_DEFAULT_QUEUE) :
+       spAutoQueue(graph, mode);
+
+   if (mode != SP_MODE_SS) {
+     printf("p res p2p q %s\n", queue->name);
+     parse_p2p(&nQ, &source_array, &sink_array, aName);
+   }
+   else {
+     printf("p res ss %s\n", queue->name);
+     parse_ss(&nQ, &source_array, aName);
+   }
+   if (newId != NULL) {
+     reorderQueries(source_array, nQ, newId, n, aName);
+     if (mode != SP_MODE_SS)
+       reorderQueries(sink_array, nQ, newId, n, aName);
+   }
 
    fprintf(oFile, "f %s %s\n", gName, aName);
 
    fprintf(stderr,"c\n");
 
-   ArcLen(n, nodes, &minArcLen, &maxArcLen);      // other useful stats
+   ArcLen(graph, &minArcLen, &maxArcLen);      // other useful stats
 
    // sanity check
    dDist = maxArcLen * (double) (n-1);
@@ -98,52 +344,43 @@ int main(int argc, char **argv)
      fprintf(stderr, "         proceed at your own risk!\n");
    }
 
+   // heap keys are the narrowest type that holds any distance
+   // (A* keys add a lower bound of up to the same size)
+   params.wideKeys = (dDist * (mode == SP_MODE_ASTAR || mode == SP_MODE_ALT ?
+			       2 : 1) > (double) INT_MAX);
+
    // figure out what algorithm to use
-   cLevels = 0;
-   logDelta = 0;
-   szAlgorithm = SZ_DIK_HEAP;
-#ifdef MLB
-   szAlgorithm = SZ_DIK_MLB;
-#endif
-   if (argc == 3) {
-     param = atoi(argv[4]);
-     
+   szAlgorithm = queue->desc;
+   if (nArgs == 4) {
+     param = atoi(args[3]);
+
      if (param == -99) { // this special case goes first
        // do breadth-first search
        szAlgorithm = SZ_BFS;
        doBFS = true;
      }
      else {
-       if (param == 0) {
-	 // cLevel and delta will be optimized in smartq.cc
-	 cLevels = 0;
-	 logDelta = 0;
-       }
-       
+       // with 0, cLevel and delta will be optimized in smartq.cc
        if (param > 0) {
-	 cLevels = (ulong) param;
+	 params.levels = (ulong) param;
        }
        if (param < 0) {
-	 logDelta = (ulong) -param;
+	 params.logDelta = (ulong) -param;
        }
      }
    }
-   else {
-     // cLevel and delta will be optimized in smartq.cc
-     cLevels = 0;
-     logDelta = 0;
-   }
 
-   sp = new SP(n, nodes, cLevels, logDelta, doBFS);
+   sp = new SP(graph, nodes, queue->type, mode, &params, doBFS);
 
    if (doBFS) {  // get baseline timing
+     source = nodes + source_array[0] - 1;
      tm = timer();
      dist = sp->BFS(source);
      tm = (timer() - tm);             // give an avg time
 
-     ArcLen(n, nodes, &minArcLen, &maxArcLen);      // other useful stats
-   
-     fprintf(stderr,"c %s (%s)\n", szAlgorithm, argv[1]);
+     ArcLen(graph, &minArcLen, &maxArcLen);      // other useful stats
+
+     fprintf(stderr,"c %s (%s)\n", szAlgorithm, gName);
      fprintf(stderr,"c Nodes: %20ld       Arcs: %19ld\n",  n, m);
      fprintf(stderr,"c Baseline timing\n");
      fprintf(stderr,"c Time: %21.2f       MaxArcLen: %14lld\n", tm, maxArcLen);
@@ -153,65 +390,91 @@ int main(int argc, char **argv)
    else {
      sp->init();
 
+     fprintf(stderr,"c %s (%s)\n", szAlgorithm, spModeName(mode));
      fprintf(stderr,"c Nodes: %24ld       Arcs: %22ld\n",  n, m);
-     fprintf(stderr,"c MinArcLen: %20lld       MaxArcLen: %17lld\n", 
+     fprintf(stderr,"c MinArcLen: %20lld       MaxArcLen: %17lld\n",
 	    minArcLen, maxArcLen);
-     fprintf(stderr,"c Trials: %23ld\n", nQ);
+     fprintf(stderr,"c Trials: %23ld       Heap keys: %14d-bit\n",
+	     nQ, params.wideKeys ? 64 : 32);
+     fprintf(stderr,"c Arc layout: %15d-bit       Node order: %17s\n",
+	     graph->arcs32 != NULL ? 32 : 64, reorderMethodName(order));
 
-     dist = 0;
-     
-     tm = timer();          // start timing
-     for (int i = 0; i < nQ; i++) {
-#ifdef SINGLE_PAIR
-       source = nodes + source_array[i] - 1;
-       sink = nodes + sink_array[i] - 1;
-       sp->initS(source);
-       sp->sp(source, sink);
-#ifdef CHECKSUM
-       if (sink->tStamp != source->tStamp)
-	 fprintf(stderr,"c No path found\n");
-       else {
-	 dist = sink->dist;
-	 fprintf(oFile,"d %lld\n", dist);
+     // one SP per thread; thread 0 uses the labels allocated above
+     // (delta-stepping spends the threads inside each search)
+     threads = params.threads < 1 || queue->type == SP_DIK_DELTA ?
+       1 : params.threads;
+     if (threads > nQ)
+       threads = nQ > 0 ? nQ : 1;
+     queries.sp = new SP *[threads];
+     queries.nodes = new Node *[threads];
+     queries.sp[0] = sp;
+     queries.nodes[0] = nodes;
+     for (t = 1; t < threads; t++) {
+       queries.nodes[t] = (Node *) calloc(n + 1, sizeof(Node));
+       if (queries.nodes[t] == NULL) {
+	 fprintf(stderr, "ERROR: can't allocate query labels\n");
+	 exit(1);
        }
-#endif	 
-#else
-       source = nodes + source_array[i] - 1;
-       sp->initS(source);
-       sp->sp(source);
-#ifdef CHECKSUM
-       dist = source->dist;
-       for ( node = nodes; node < nodes + n; node++ )
-	 if (node->tStamp == sp->curTime) {
-	   dist = (dist + (node->dist % MODUL)) % MODUL;
-	 }
-       fprintf(oFile,"d %lld\n", dist);
-#endif
-       
-#endif
+       queries.sp[t] = new SP(sp, queries.nodes[t]);
+       queries.sp[t]->init();
      }
+     queries.n = n;
+     queries.source_array = source_array;
+     queries.sink_array = (mode != SP_MODE_SS) ? sink_array : NULL;
+     queries.checksum = checksum;
+     queries.dist = new long long[nQ];
+     queries.found = new bool[nQ];
+
+     tm = timer();          // start timing
+     wall = wallTimer();
+     poolRun(nQ, threads, runQuery, &queries);
      tm = (timer() - tm);   // finish timing
+     wall = (wallTimer() - wall);
 
-#ifndef CHECKSUM
-     // now print the sp-specific stats
-     sp->PrintStats(nQ);
-     /* *round* the time to the nearest .01 of ms */
-     fprintf(stderr,"c Time (ave, ms): %18.2f\n", 
-	    1000.0 * tm/(float) nQ);
-
-     fprintf(oFile, "g %ld %ld %lld %lld\n", 
-	     n, m, minArcLen, maxArcLen);
-     fprintf(oFile, "t %f\n", 1000.0 * tm/(float) nQ);
-     fprintf(oFile, "v %f\n", (float) sp->cScans/ (float) nQ);
-     fprintf(oFile, "i %f\n", (float) sp->cUpdates/ (float) nQ);
-#endif
+     for (t = 1; t < threads; t++) {
+       sp->cScans += queries.sp[t]->cScans;
+       sp->cUpdates += queries.sp[t]->cUpdates;
+       delete queries.sp[t];
+       free(queries.nodes[t]);
+     }
+
+     if (checksum) {
+       for (int i = 0; i < nQ; i++)
+	 if (!queries.found[i])
+	   fprintf(stderr,"c No path found\n");
+	 else
+	   fprintf(oFile,"d %lld\n", queries.dist[i]);
+     }
+     delete [] queries.sp;
+     delete [] queries.nodes;
+     delete [] queries.dist;
+     delete [] queries.found;
+
+     if (!checksum) {
+       // now print the sp-specific stats
+       sp->PrintStats(nQ);
+       /* *round* the time to the nearest .01 of ms */
+       fprintf(stderr,"c Time (ave, ms): %18.2f\n",
+	       1000.0 * tm/(float) nQ);
+       if (params.threads > 1)
+	 fprintf(stderr,"c Wall time (ms): %18.2f       Threads: %19d\n",
+		 1000.0 * wall, params.threads);
+
+       fprintf(oFile, "g %ld %ld %lld %lld\n",
+	       n, m, minArcLen, maxArcLen);
+       fprintf(oFile, "t %f\n", 1000.0 * tm/(float) nQ);
+       fprintf(oFile, "v %f\n", (float) sp->cScans/ (float) nQ);
+       fprintf(oFile, "i %f\n", (float) sp->cUpdates/ (float) nQ);
+     }
    }
 
-   sp->~SP();
+   delete sp;
+   free(nodes);
+   csr_free(graph);
+   free(newId);
    free(source_array);
-#ifdef SINGLE_PAIR
-   free(sink_array);
-#endif   
+   if (sink_array)
+     free(sink_array);
    fclose(oFile);
 
    return 0;
@@ -1,6 +1,6 @@
 /* nodearc.h  by Andrew Goldberg, started 5/25/01
- *     Contains the definition of the node and arc class needed
- *     for all the code.
+ *     Contains the definition of the node labels needed for all the
+ *     code.
  */
 
 #ifndef NODEARC_H
@@ -12,32 +12,14 @@
 #define IN_BUCKETS    4
 #define IN_SCANNED    5
 
-typedef struct Node;      // so the arc knows about it
-   
-typedef struct Arc {
-  long long len;         // arc length; long long may be an overkill
-  struct Node *head;     // where the arc ends up
-} Arc;
-
+// The labels of a search, one per node, hold only what every scan
+// reads and writes.  Parents (SP::getParents), arcs (csr.h), and
+// bucket links and calibers (smartq.h, dial.h) live in arrays of
+// their own, indexed like the labels, so a label fits in 16 bytes.
 typedef struct Node {
   long long dist;        // tentative shortest path length to some node
-  Arc   *first;          // first outgoing arc
-  struct Node *parent;   // parent on the heap
+  unsigned int tStamp;   // search that set the label (SP::curTime)
   char where;   // what data structure we're in:  IN_* (above)
-  unsigned int tStamp;
-
-  struct {
-    struct Node *next;          // next in bucket
-    struct Node *prev;          // prev in bucket
-    void *bucket;               // you should cast this
-#ifndef MLB
-    long long caliber;          // minimum incoming arc length
-#endif
-  } sBckInfo;                   // FOR SMART BUCKETS
-
-
-
-
 } Node;
 
 
@@ -0,0 +1,72 @@
+#include "pairheap.h"
+
+
+template <class KeyType>
+PairHeap_Wrapper<KeyType>::PairHeap_Wrapper(CSRGraph *graphGiven)
+{
+    graph = graphGiven;
+    instance = new PairHeap<long, KeyType, PAIRING_IS_MULTIPASS>();
+    pool = new PairingNode[graph->n];
+    for(long q=0;q<graph->n;q++)
+        pool[q].element = q;      //Insert sets the links
+}
+
+template <class KeyType>
+PairHeap_Wrapper<KeyType>::~PairHeap_Wrapper()
+{
+    delete instance;
+    delete [] pool;
+}
+
+template <class KeyType>
+typename PairHeap_Wrapper<KeyType>::PairingNode *PairHeap_Wrapper<KeyType>::RemoveMin()
+{
+    PairingNode *res = instance->GetMin();
+    if (!res)
+        return NULL;
+    instance->RemoveMin();
+    return res;
+}
+
+template <class KeyType>
+void PairHeap_Wrapper<KeyType>::Clear()
+{
+    instance->Clear();
+}
+
+template <class KeyType>
+void PairHeap_Wrapper<KeyType>::Push(long v, long long key)
+{
+    PairingNode *x = pool + v;
+    x->key = (KeyType) key;
+    instance->Insert(x);
+}
+
+template <class KeyType>
+void PairHeap_Wrapper<KeyType>::Decrease(long v, long long key)
+{
+    instance->Decrease(pool + v, (KeyType) key);
+}
+
+template <class KeyType>
+long PairHeap_Wrapper<KeyType>::PopMin()
+{
+    PairingNode *x = RemoveMin();
+    return x ? x->element : -1;
+}
+
+template <class KeyType>
+long long PairHeap_Wrapper<KeyType>::MinKey()
+{
+    return instance->GetMin()->key;
+}
+
+template <class KeyType>
+bool PairHeap_Wrapper<KeyType>::IsEmpty()
+{
+    return instance->GetMin() == NULL;
+}
+
+//the two key widths the driver chooses from
+template class PairHeap_Wrapper<int>;
+template class PairHeap_Wrapper<long long>;
@@ -0,0 +1,50 @@
+#ifndef PAIRHEAP_H
+#define PAIRHEAP_H
+
+#include "pairheap_core.h"
+#include "nodearc.h"
+#include "csr.h"
+#include "sp.h" //get shortest path wrapper class
+
+#ifndef ulong
+typedef unsigned long ulong; // to get that extra bit
+#endif
+
+//build with -DPAIRING_MULTIPASS for multipass rather than two-pass
+//pairing (see pairheap_core.h)
+#ifdef PAIRING_MULTIPASS
+#define PAIRING_IS_MULTIPASS  true
+#define PAIRING_DESC          "Dijkstra with Pairing Heap (multipass)"
+#else
+#define PAIRING_IS_MULTIPASS  false
+#define PAIRING_DESC          "Dijkstra with Pairing Heap (two-pass)"
+#endif
+
+//a heap node only carries the index of its graph node in the CSR graph.
+//KeyType is int or long long, chosen by the driver from the largest
+//possible distance; instantiations live in pairheap.cc.
+template <class KeyType>
+class PairHeap_Wrapper{
+public:
+    typedef PairNode<long, KeyType> PairingNode;
+private:
+    PairHeap<long, KeyType, PAIRING_IS_MULTIPASS> * instance;
+    CSRGraph *graph;     //shared, read-only
+    PairingNode *pool;   //pool[v] is the heap node of graph node v
+public:
+    PairHeap_Wrapper(CSRGraph *graph);
+
+    ~PairHeap_Wrapper();
+    PairingNode *RemoveMin();
+
+    //queue interface the searches run on (HeapEngine in engine.cc,
+    //bidir.h and the others); v is a node index, keys are distances
+    void Clear();
+    void Push(long v, long long key);
+    void Decrease(long v, long long key);
+    long PopMin();             //-1 if empty
+    long long MinKey();        //must not be empty
+    bool IsEmpty();
+};
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef PAIRHEAP_CORE_H
+#define PAIRHEAP_CORE_H
+
+#include <cstdlib>
+
+// Pairing heap (Fredman, Sedgewick, Sleator and Tarjan).  A heap is
+// one tree; each node keeps its first child and its siblings, the
+// first child's prev pointing to the parent.  Insert and decrease
+// link a single tree with the root; RemoveMin links the root's
+// children back into one tree, either
+//
+//   two-pass   (MultiPass false) pairs left to right, then folds the
+//              pairs into one right to left
+//   multipass  (MultiPass true) links the first two trees and puts
+//              the result at the back, until one is left
+//
+// Nodes belong to the caller, who allocates one per element and
+// hands it in; the heap never allocates.
+
+template <class ElementType, class KeyType = int>
+struct PairNode
+{
+    ElementType element; // element data
+    KeyType key; // key value
+    PairNode<ElementType, KeyType>* child; // first child ptr
+    PairNode<ElementType, KeyType>* next; // next sibling ptr
+    PairNode<ElementType, KeyType>* prev; // previous sibling ptr, or parent of a first child
+};
+
+template <class ElementType, class KeyType = int, bool MultiPass = false>
+class PairHeap {
+public:
+    typedef PairNode<ElementType, KeyType> HeapNode;
+private:
+    HeapNode* m_root; // the one tree
+
+    // Make the root with the larger key the first child of the other;
+    // returns the other.
+    HeapNode* Link(HeapNode* a, HeapNode* b);
+
+    // Link the sibling list starting at first into one tree.
+    HeapNode* TwoPass(HeapNode* first);
+    HeapNode* Multipass(HeapNode* first);
+
+public:
+    // Constructor.
+    PairHeap() { m_root = NULL; }
+
+    // Insert node into heap.
+    void Insert(HeapNode* node);
+
+    // Decrease node's key to "KeyType key".
+    void Decrease(HeapNode* node, KeyType key);
+
+    // Remove min node.
+    void RemoveMin();
+
+    // Get min node, or NULL if the heap is empty.
+    HeapNode* GetMin() { return m_root; }
+
+    // Empty the heap in O(1); nodes still linked are simply dropped.
+    void Clear() { m_root = NULL; }
+};
+
+template <class ElementType, class KeyType, bool MultiPass>
+inline typename PairHeap<ElementType, KeyType, MultiPass>::HeapNode*
+PairHeap<ElementType, KeyType, MultiPass>::Link(HeapNode* a, HeapNode* b)
+{
+    HeapNode* t;
+
+    if (b->key < a->key) {
+        t = a;
+        a = b;
+        b = t;
+    }
+    b->next = a->child;
+    if (a->child)
+        a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    return a;
+}
+
+template <class ElementType, class KeyType, bool MultiPass>
+typename PairHeap<ElementType, KeyType, MultiPass>::HeapNode*
+PairHeap<ElementType, KeyType, MultiPass>::TwoPass(HeapNode* first)
+{
+    HeapNode *a, *b, *list = NULL, *root, *next;
+
+    // first pass: link pairs, stacking the results through next
+    while (first) {
+        a = first;
+        b = a->next;
+        if (b == NULL) {
+            a->next = list;
+            list = a;
+            break;
+        }
+        first = b->next;
+        a = Link(a, b);
+        a->next = list;
+        list = a;
+    }
+
+    // second pass: fold the stack, i.e. the pairs right to left
+    root = list;
+    list = list->next;
+    while (list) {
+        next = list->next;
+        root = Link(root, list);
+        list = next;
+    }
+    return root;
+}
+
+template <class ElementType, class KeyType, bool MultiPass>
+typename PairHeap<ElementType, KeyType, MultiPass>::HeapNode*
+PairHeap<ElementType, KeyType, MultiPass>::Multipass(HeapNode* first)
+{
+    HeapNode *head = first, *tail, *a, *b, *c;
+
+    for (tail = first; tail->next; tail = tail->next)
+        ;
+    // the siblings form a queue through next; the result of each
+    // link goes to the back
+    while (head->next) {
+        a = head;
+        b = a->next;
+        head = b->next;
+        c = Link(a, b);
+        c->next = NULL;
+        if (head) {
+            tail->next = c;
+            tail = c;
+        }
+        else
+            head = c;
+    }
+    return head;
+}
+
+template <class ElementType, class KeyType, bool MultiPass>
+void PairHeap<ElementType, KeyType, MultiPass>::Insert(HeapNode* node)
+{
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+    m_root = m_root ? Link(m_root, node) : node;
+}
+
+template <class ElementType, class KeyType, bool MultiPass>
+void PairHeap<ElementType, KeyType, MultiPass>::Decrease(HeapNode* node, KeyType key)
+{
+    node->key = key;
+    if (node == m_root)
+        return;
+    // cut node's subtree from its siblings and link it with the root
+    if (node->prev->child == node)
+        node->prev->child = node->next;
+    else
+        node->prev->next = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+    m_root = Link(m_root, node);
+}
+
+template <class ElementType, class KeyType, bool MultiPass>
+void PairHeap<ElementType, KeyType, MultiPass>::RemoveMin()
+{
+    HeapNode* first = m_root->child;
+
+    if (first == NULL) {
+        m_root = NULL;
+        return;
+    }
+    m_root = MultiPass ? Multipass(first) : TwoPass(first);
+    m_root->next = NULL;
+    m_root->prev = NULL;
+}
+
+#endif
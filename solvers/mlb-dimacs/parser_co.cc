@@ -0,0 +1,138 @@
+/* parser_co.cc
+ *     Reads a DIMACS node-coordinate aux file:
+ *
+ *       p aux sp co n
+ *       v id X Y
+ *
+ *     n must be the number of nodes of the graph and each node must
+ *     have exactly one coordinate line.  x[id-1], y[id-1] receive
+ *     the coordinates.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+int parse_co(long nGraph, long **x_array, long **y_array, char *coName)
+
+// long    nGraph;                 /* number of nodes in the graph */
+// long    **x_array, **y_array;   /* pointers to the coordinate arrays */
+{
+
+#define MAXLINE       100	/* max line length in the input file */
+#define P_FIELDS        4       /* no of fields in problem line */
+#define AUX_TYPE "aux"          /* denotes auxilary file */
+#define PROBLEM_TYPE "sp"       /* name of problem type*/
+#define PROBLEM_VAR "co"        /* node coordinates */
+
+  long    n = 0;                  /* number of coordinate lines */
+  long   *x=NULL, *y=NULL;        /* internal coordinate arrays */
+  char   *seen=NULL;              /* nodes that have a line already */
+  long id, cx, cy;
+  char prA_type[4], pr_type[3], pr_var[3], in_line[MAXLINE];
+  long no_lines= 0, no_plines=0, no_vlines=0;
+  const char *err_message = "wrong line format";
+  FILE *coFile;
+
+
+ coFile = fopen(coName, "r");
+ if (coFile == NULL) {
+   fprintf(stderr, "ERROR: file %s not found\n", coName);
+   exit(1);
+ }
+
+while (fgets(in_line, MAXLINE, coFile) != NULL)
+  {
+  no_lines ++;
+
+
+  switch (in_line[0])
+    {
+    case 'c':                  /* skip lines with comments */
+    case '\n':                 /* skip empty lines   */
+    case '\0':                 /* skip empty lines at the end of file */
+      break;
+
+    case 'p':                  /* problem description      */
+      if ( no_plines > 0 )
+	{ err_message = "more than one problem line"; goto error; }
+
+      no_plines = 1;
+
+      if (
+	  sscanf( in_line, "%*c %3s %2s %2s %ld",
+		  prA_type, pr_type, pr_var, &n )
+	  != P_FIELDS
+	  )
+	{ err_message = "wrong problem line"; goto error; }
+
+      if ( strcmp ( prA_type, AUX_TYPE ) ||
+	   strcmp ( pr_type, PROBLEM_TYPE ) ||
+	   strcmp ( pr_var, PROBLEM_VAR ) )
+	{ err_message = "not a coordinate file"; goto error; }
+
+      if ( n != nGraph )
+	{ err_message = "number of nodes differs from the graph"; goto error; }
+
+      x    = (long *) calloc(n, sizeof(long));
+      y    = (long *) calloc(n, sizeof(long));
+      seen = (char *) calloc(n, sizeof(char));
+      if ( x == NULL || y == NULL || seen == NULL )
+	{ err_message = "can't obtain enough memory"; goto error; }
+
+      break;
+    case 'v':		         /* coordinate line */
+      if ( no_plines == 0 )
+	{ err_message = "no problem line before coordinates"; goto error; }
+
+      if ( sscanf ( in_line,"%*c %ld %ld %ld", &id, &cx, &cy ) != 3 )
+	{ goto error; }
+
+      if ( id < 1 || id > n )
+	{ err_message = "node id out of range"; goto error; }
+
+      if ( seen[id-1] )
+	{ err_message = "node has two coordinate lines"; goto error; }
+
+      seen[id-1] = 1;
+      x[id-1] = cx;
+      y[id-1] = cy;
+      no_vlines++;
+
+      break;
+    default:
+      /* unknown type of line */
+      err_message = "unknown line type";
+      goto error;
+      break;
+
+    } /* end of switch */
+}     /* end of input loop */
+
+
+if ( feof (coFile) == 0 ) /* reading error */
+  { err_message = "reading error"; goto error; }
+
+if ( no_plines == 0 )     /* empty input */
+  { err_message = "no problem line"; goto error; }
+
+if ( no_vlines != n )
+  { err_message = "some nodes have no coordinates"; goto error; }
+
+ fclose(coFile);
+ free(seen);
+ *x_array = x;
+ *y_array = y;
+
+ return (0);
+
+/* ---------------------------------- */
+ error:  /* error found reading input */
+
+ fprintf ( stderr, "Error parsing coordinate file %s: line %ld: %s\n",
+	   coName, no_lines, err_message);
+
+exit (1);
+
+}
+/* --------------------   end of parser  -------------------*/
@@ -2,71 +2,39 @@
 /*                                                                  */
 /*  parse (...) :                                                   */
 /*       1. Reads shortest path problem in extended DIMACS format.  */
-/*       2. Prepares internal data representation #1.               */
+/*       2. Builds the CSR graph (csr.h) directly.                  */
 /*                                                                  */
 /********************************************************************/
-       
-/* files to be included: */
+
+/* The file is mapped into memory.  The problem line is read first;
+   the rest is cut at line boundaries into chunks that threads parse
+   on their own (pool.h) with a hand-written integer scanner, after a
+   quick pass that counts the lines and arcs of each chunk so every
+   chunk knows its first line number and where its arcs go.  Arcs are
+   then ordered by tail with a counting sort over blocks of chunks,
+   one block per thread: each block counts its own arcs per tail, a
+   prefix sum over (tail, block) gives each block its own positions
+   for every tail, and each block moves its own arcs there.  Every
+   arc is read once per pass; the counts take threads * (n+2) longs.
+   Arcs of a tail keep their input order, so the result does not
+   depend on the number of threads.
+
+   Errors are reported as before, with the number of the offending
+   line; of several, the first in the file wins. */
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include "nodearc.h"
-
-/* ----------------------------------------------------------------- */
-int parse_gr( long *n_ad, long *m_ad, Node **nodes_ad, Arc **arcs_ad, 
-	   long *node_min_ad, char *gName )
-
-/* all parameters are output */
-// long    *n_ad;                 /* address of the number of nodes */
-// long    *m_ad;                 /* address of the number of arcs */
-// Node    **nodes_ad;            /* address of the array of nodes */
-// Arc     **arcs_ad;             /* address of the array of arcs */
-// long    *node_min_ad;          /* address of the minimal node */
-// char    *gName;                /* pointer to the string with file name */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "csr.h"
+#include "pool.h"
 
-{
-
-#define MAXLINE       100	/* max line length in the input file */
-#define ARC_FIELDS      3	/* no of fields in arc input  */
 #define P_FIELDS        3       /* no of fields in problem line */
 #define PROBLEM_TYPE "sp"       /* name of problem type*/
-#define DEFAULT_NAME "unknown"  /* default name of the problem */
-
-
-long    n,                      /* internal number of nodes */
-        node_min=1,               /* minimal no of node  */
-        node_max=0,               /* maximal no of nodes */
-       *arc_first=NULL,              /* internal array for holding
-                                     - node degree
-                                     - position of the first outgoing arc */
-       *arc_tail=NULL,               /* internal array: tails of the arcs */
-
-        /* temporary variables carrying no of nodes */
-        head, tail, i;
-
-long    m,                      /* internal number of arcs */
-        /* temporary variable carrying no of arcs */
-        last, arc_num, arc_new_num;
-
-Node    *nodes=NULL;                 /* pointer to the node structure */
-
-Arc     *arcs=NULL,                  /* pointer to the arc structure */
-        *arc_current=NULL,
-        *arc_new;
-
-long long length=0;               /* length of the current arc */
-
-long    no_lines=0,             /* no of current input line */
-        no_plines=0,            /* no of problem-lines */
-        no_alines=0;            /* no of arc-lines */
-
-char    in_line[MAXLINE],       /* for reading input line */
-        pr_type[3];             /* for reading type of the problem */
-
- FILE *gFile;
-
-int        err_no;                 /* no of detected error */
+#define CHUNKS_PER_THREAD 4     /* chunks per thread, for balance */
 
 /* -------------- error numbers & error messages ---------------- */
 #define EN1   0
@@ -91,8 +59,8 @@ int        err_no;                 /* no of detected error */
 #define EN20 19
 #define EN22 20
 
-static char *err_message[] = 
-  { 
+static const char *err_message[] =
+  {
 /* 0*/    "more than one problem line.",
 /* 1*/    "wrong number of parameters in the problem line.",
 /* 2*/    "it is not a Shortest Path problem line.",
@@ -114,226 +82,415 @@ static char *err_message[] =
 /*18*/    "not enough arcs in the input.",
 /*20*/    "can't read anything from the input file."
   };
-/* --------------------------------------------------------------- */
-
-/* The main loop:
-        -  reads the line of the input,
-        -  analises its type,
-        -  checks correctness of parameters,
-        -  puts data to the arrays,
-        -  does service functions
-*/
-
- gFile = fopen(gName, "r");
- if (gFile == NULL) {
-   fprintf(stderr, "ERROR: file %s not found\n", gName);
-   exit(1);
- }
-
-while (fgets(in_line, MAXLINE, gFile) != NULL)
-  {
-  no_lines ++;
-
-
-  switch (in_line[0])
-    {
-      case 'c':                  /* skip lines with comments */
-      case '\n':                 /* skip empty lines   */
-      case '\0':                 /* skip empty lines at the end of file */
-                break;
-
-      case 'p':                  /* problem description      */
-                if ( no_plines > 0 )
-                   /* more than one problem line */
-                   { err_no = EN1 ; goto error; }
-
-                no_plines = 1;
-   
-                if (
-        /* reading problem line: type of problem, no of nodes, no of arcs */
-                    sscanf ( in_line, "%*c %2s %ld %ld", pr_type, &n, &m )
-                != P_FIELDS
-                   )
-		    /*wrong number of parameters in the problem line*/
-		    { err_no = EN2; goto error; }
-
-                if ( strcmp ( pr_type, PROBLEM_TYPE ) )
-		    /*wrong problem type*/
-		    { err_no = EN3; goto error; }
-
-                if ( n <= 0  || m <= 0 )
-		    /*wrong value of no of arcs or nodes*/
-		    { err_no = EN4; goto error; }
-
-        /* allocating memory for  'nodes', 'arcs'  and internal arrays */
-                nodes    = (Node*) calloc ( n+2, sizeof(Node) );
-		arcs     = (Arc*)  calloc ( m+1, sizeof(Arc) );
-	        arc_tail = (long*) calloc ( m,   sizeof(long) ); 
-		arc_first= (long*) calloc ( n+2, sizeof(long) );
-                /* arc_first [ 0 .. n+1 ] = 0 - initialized by calloc */
-
-                if ( nodes == NULL || arcs == NULL || 
-                     arc_first == NULL || arc_tail == NULL )
-                    /* memory is not allocated */
-		    { 
-		      printf("Need %lld bytes for data and %lld bytes temp. data\n", 
-			     ((long long) (n+2))*((long long) sizeof(Node))+
-			     ((long long) (m+1))*((long long) sizeof(Arc)),
-			     ((long long) (n+m+2))*((long long) sizeof(long)));
-		      err_no = EN6; goto error; 
-		    }
-		     
-		/* setting pointer to the current arc */
-		arc_current = arcs;
-                break;
-
-      case 'a':                    /* arc description */
-
-		if ( no_alines >= m )
-                  /*too many arcs on input*/
-                  { err_no = EN16; goto error; }
-
-		if (
-                    /* reading an arc description */
-                    sscanf ( in_line,"%*c %ld %ld %lld",
-                                      &tail, &head, &length )
-                    != 3 
-                   ) 
-                    /* arc description is not correct */
-                    { err_no = EN15; goto error; }
-		if ( tail < 0  ||  tail > n  ||
-                     head < 0  ||  head > n  
-		   )
-                    /* wrong value of nodes */
-		    { err_no = EN17; goto error; }
-
-		arc_first[tail + 1] ++; /* no of arcs outgoing from tail
-                                           is stored in arc_first[tail+1] */
-
-                /* storing information about the arc */
-		arc_tail[no_alines] = tail;
-		arc_current -> head = nodes + head;
-		arc_current -> len  = length;
-
-		/* searching minimumu and maximum node */
-                if ( head < node_min ) node_min = head;
-                if ( tail < node_min ) node_min = tail;
-                if ( head > node_max ) node_max = head;
-                if ( tail > node_max ) node_max = tail;
-
-		no_alines ++;
-		arc_current ++;
-		break;
-
-	default:
-		/* unknown type of line */
-		err_no = EN18; goto error;
-		break;
-
-    } /* end of switch */
-}     /* end of input loop */
-
-/* ----- all is red  or  error while reading ----- */ 
-
-if ( feof (gFile) == 0 ) /* reading error */
-  { err_no=EN21; goto error; } 
-
-if ( no_lines == 0 ) /* empty input */
-  { err_no = EN22; goto error; } 
-
-if ( no_alines < m ) /* not enough arcs */
-  { err_no = EN19; goto error; } 
-
-  
-/********** ordering arcs - linear time algorithm ***********/
-
-/* first arc from the first node */
-( nodes + node_min ) -> first = arcs;
-
-/* before below loop arc_first[i+1] is the number of arcs outgoing from i;
-   after this loop arc_first[i] is the position of the first 
-   outgoing from node i arcs after they would be ordered;
-   this value is transformed to pointer and written to node.first[i]
-   */
- 
-for ( i = node_min + 1; i <= node_max + 1; i ++ ) 
-  {
-    arc_first[i]          += arc_first[i-1];
-    ( nodes + i ) -> first = arcs + arc_first[i];
-  }
 
+static void parse_error(int err_no, long line)
+{
+  printf ( "\nPrs%d: line %ld of input - %s\n",
+	   err_no, line, err_message[err_no] );
+  exit (1);
+}
 
-for ( i = node_min; i < node_max; i ++ ) /* scanning all the nodes  
-                                            exept the last*/
-  {
-
-    last = ( ( nodes + i + 1 ) -> first ) - arcs;
-                             /* arcs outgoing from i must be cited    
-                              from position arc_first[i] to the position
-                              equal to initial value of arc_first[i+1]-1  */
-
-    for ( arc_num = arc_first[i]; arc_num < last; arc_num ++ )
-      { tail = arc_tail[arc_num];
-
-	while ( tail != i )
-          /* the arc no  arc_num  is not in place because arc cited here
-             must go out from i;
-             we'll put it to its place and continue this process
-             until an arc in this position would go out from i */
+/* --------------------------------------------------------------- */
 
-	  { Arc arc_tmp;        /* used in swapping below */
-            arc_new_num  = arc_first[tail];
-	    arc_current  = arcs + arc_num;
-	    arc_new      = arcs + arc_new_num;
-	    
-	    /* arc_current must be cited in the position arc_new    
-	       swapping these arcs:                                 */
+/* reads a number as sscanf's %lld would: blanks, a sign, digits.
+   Returns the first character after it, or NULL if there is none;
+   p never runs past end, which is a newline or the end of file */
+static inline const char *scan_number(const char *p, const char *end,
+				      long long *value)
+{
+  long long v = 0;
+  bool negative = false;
+
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' ||
+		     *p == '\v' || *p == '\f'))
+    p++;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = (*p++ == '-');
+  if (p == end || *p < '0' || *p > '9')
+    return NULL;
+  while (p < end && *p >= '0' && *p <= '9')
+    v = 10 * v + (*p++ - '0');
+  *value = negative ? -v : v;
+  return p;
+}
 
-	    arc_tmp.head         = arc_new -> head;
-	    arc_new -> head      = arc_current -> head;
-	    arc_current -> head = arc_tmp.head;
+static inline const char *line_end(const char *p, const char *end)
+{
+  const char *nl = (const char *) memchr(p, '\n', end - p);
 
-	    arc_tmp.len         = arc_new -> len;
-	    arc_new -> len      = arc_current -> len;
-	    arc_current -> len = arc_tmp.len;
+  return nl ? nl : end;
+}
 
-	    arc_tail[arc_num] = arc_tail[arc_new_num];
+typedef struct GrChunk {
+  const char *begin, *end;  // whole lines
+  long lines;               // lines in the chunk
+  long arcLines;            // arc lines in the chunk
+  long firstLine;           // number of the line before the chunk
+  long firstArc;            // index of the chunk's first arc
+  long nodeMin, nodeMax;    // over the chunk's arcs
+  int err_no;               // first error in the chunk, or -1
+  long errLine;             // and its line
+} GrChunk;
+
+typedef struct GrState {
+  GrChunk *chunk;
+  long n, m;
+  long node_min;            // node node_min is node 0 of the graph
+  CSRArc *arcs;             // in input order, heads as read
+  long *arc_tail;
+  CSRGraph *graph;          // arcs ordered by tail
+  long *arc_first;          // n+2 positions, where each tail starts
+  long blocks;              // the arcs are sorted in this many blocks
+  long *blockArc;           // first arc of each block, and m
+  long **count;             // count[b][t]: arcs of block b out of tail
+                            // t, then where the next of them goes
+  long ranges;              // tails are split into this many ranges
+  long *rangeStart;         // arcs with a tail in each range, then
+                            // where they start
+} GrState;
+
+/* counts the lines and arc lines of a chunk */
+static void count_chunk(long job, int, void *arg)
+{
+  GrChunk *c = ((GrState *) arg)->chunk + job;
+  const char *p, *eol;
+
+  c->lines = c->arcLines = 0;
+  for (p = c->begin; p < c->end; p = eol + 1) {
+    eol = line_end(p, c->end);
+    c->lines++;
+    if (*p == 'a')
+      c->arcLines++;
+  }
+}
 
-	    /* we increase arc_first[tail] but label previous position */
+/* parses the lines of a chunk, stopping at its first error */
+static void parse_chunk(long job, int, void *arg)
+{
+  GrState *s = (GrState *) arg;
+  GrChunk *c = s->chunk + job;
+  const char *p, *q, *eol;
+  long line = c->firstLine, arc = c->firstArc;
+  long long tail, head, length;
+
+  c->err_no = -1;
+  c->nodeMin = s->n + 1;
+  c->nodeMax = -1;
+  for (p = c->begin; p < c->end; p = eol + 1) {
+    eol = line_end(p, c->end);
+    line++;
+    switch (*p) {
+    case 'c':                  /* skip lines with comments */
+    case '\n':                 /* skip empty lines   */
+    case '\0':                 /* skip empty lines at the end of file */
+      break;
+
+    case 'p':
+      c->err_no = EN1;         /* more than one problem line */
+      break;
+
+    case 'a':                  /* arc description */
+      if (arc >= s->m) {       /* too many arcs on input */
+	c->err_no = EN16;
+	break;
+      }
+      if ((q = scan_number(p + 1, eol, &tail)) == NULL ||
+	  (q = scan_number(q, eol, &head)) == NULL ||
+	  (q = scan_number(q, eol, &length)) == NULL) {
+	c->err_no = EN15;      /* arc description is not correct */
+	break;
+      }
+      if (tail < 0 || tail > s->n || head < 0 || head > s->n) {
+	c->err_no = EN17;      /* wrong value of nodes */
+	break;
+      }
+      s->arc_tail[arc] = (long) tail;
+      s->arcs[arc].head = (long) head;
+      s->arcs[arc].len = length;
+      if (head < c->nodeMin) c->nodeMin = (long) head;
+      if (tail < c->nodeMin) c->nodeMin = (long) tail;
+      if (head > c->nodeMax) c->nodeMax = (long) head;
+      if (tail > c->nodeMax) c->nodeMax = (long) tail;
+      arc++;
+      break;
+
+    default:                   /* unknown type of line */
+      c->err_no = EN18;
+      break;
+    }
+    if (c->err_no >= 0) {
+      c->errLine = line;
+      return;
+    }
+  }
+}
 
-	    arc_tail[arc_new_num] = tail;
-	    arc_first[tail] ++ ;
+/* tails lo .. hi-1 of range job */
+static void tail_range(GrState *s, long job, long *lo, long *hi)
+{
+  *lo = (s->n + 1) * job / s->ranges;
+  *hi = (s->n + 1) * (job + 1) / s->ranges;
+}
 
-            tail = arc_tail[arc_num];
-	  }
-      }
-    /* all arcs outgoing from  i  are in place */
-  }       
+/* counts the arcs out of each tail in block job */
+static void count_tails(long job, int, void *arg)
+{
+  GrState *s = (GrState *) arg;
+  long i, *count;
+
+  count = s->count[job] = (long *) calloc(s->n + 2, sizeof(long));
+  if (count == NULL)
+    parse_error(EN6, 0);
+  for (i = s->blockArc[job]; i < s->blockArc[job + 1]; i++)
+    count[s->arc_tail[i]]++;
+}
 
-/* -----------------------  arcs are ordered  ------------------------- */
+/* counts the arcs, of all blocks, out of the tails of range job */
+static void sum_tails(long job, int, void *arg)
+{
+  GrState *s = (GrState *) arg;
+  long lo, hi, t, b, total = 0;
+
+  tail_range(s, job, &lo, &hi);
+  for (t = lo; t < hi; t++)
+    for (b = 0; b < s->blocks; b++)
+      total += s->count[b][t];
+  s->rangeStart[job] = total;
+}
 
-/* assigning output values */
-*m_ad = m;
-*n_ad = node_max - node_min + 1;
-*node_min_ad = node_min;
-*nodes_ad = nodes + node_min;
-*arcs_ad = arcs;
+/* turns the counts of range job into positions from rangeStart on:
+   the arcs of a tail start at arc_first[tail], block after block */
+static void place_tails(long job, int, void *arg)
+{
+  GrState *s = (GrState *) arg;
+  long lo, hi, t, b, count, at = s->rangeStart[job];
+
+  tail_range(s, job, &lo, &hi);
+  for (t = lo; t < hi; t++) {
+    s->arc_first[t] = at;
+    for (b = 0; b < s->blocks; b++) {
+      count = s->count[b][t];
+      s->count[b][t] = at;
+      at += count;
+    }
+  }
+}
 
-/* free internal memory */
-free ( arc_first ); free ( arc_tail );
+/* moves the arcs of block job to their positions, renumbering heads
+   from node_min */
+static void move_tails(long job, int, void *arg)
+{
+  GrState *s = (GrState *) arg;
+  long i, *pos = s->count[job];
+  CSRArc *a;
+
+  for (i = s->blockArc[job]; i < s->blockArc[job + 1]; i++) {
+    a = s->graph->arcs + pos[s->arc_tail[i]]++;
+    a->len = s->arcs[i].len;
+    a->head = s->arcs[i].head - s->node_min;
+  }
+}
 
- fclose(gFile);
+/* ----------------------------------------------------------------- */
+int parse_gr_threads( long *n_ad, long *m_ad, CSRGraph **graph_ad,
+		      char *gName, int threads )
 
-/* Uff! all is done */
-return (0);
+/* all parameters but gName and threads are output */
+// long    *n_ad;                 /* address of the number of nodes */
+// long    *m_ad;                 /* address of the number of arcs */
+// CSRGraph **graph_ad;           /* address of the graph */
+// char    *gName;                /* pointer to the string with file name */
+// int     threads;               /* threads to parse and sort with */
 
-/* ---------------------------------- */
- error:  /* error found reading input */
+{
+  GrState s;
+  struct stat st;
+  const char *text, *end, *p, *eol, *cut;
+  char pr_type[3], *in_line;
+  long n = 0, m = 0, no_lines = 0, node_min, node_max, lines, arcLines;
+  long chunks, k, t, i;
+  int fd, problem = 0;
+  size_t size;
+
+  if (threads < 1)
+    threads = 1;
+
+  fd = open(gName, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "ERROR: file %s not found\n", gName);
+    exit(1);
+  }
+  if (fstat(fd, &st) != 0)
+    parse_error(EN21, 0);
+  size = (size_t) st.st_size;
+  if (size == 0)                 /* empty input */
+    parse_error(EN22, 0);
+  text = (const char *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (text == (const char *) MAP_FAILED)
+    parse_error(EN21, 0);
+  madvise((void *) text, size, MADV_SEQUENTIAL);
+  end = text + size;
+
+  /* the problem line comes first, after any comments */
+  for (p = text; p < end && !problem; p = eol + 1) {
+    eol = line_end(p, end);
+    no_lines++;
+    switch (*p) {
+    case 'c':
+    case '\n':
+    case '\0':
+      break;
+
+    case 'p':                  /* problem description      */
+      problem = 1;
+      in_line = (char *) malloc(eol - p + 1);
+      if (in_line == NULL)
+	parse_error(EN6, no_lines);
+      memcpy(in_line, p, eol - p);
+      in_line[eol - p] = '\0';
+      if (
+	  /* reading problem line: type of problem, no of nodes, no of arcs */
+	  sscanf ( in_line, "%*c %2s %ld %ld", pr_type, &n, &m )
+	  != P_FIELDS
+	  )
+	/*wrong number of parameters in the problem line*/
+	parse_error(EN2, no_lines);
+      free(in_line);
+
+      if ( strcmp ( pr_type, PROBLEM_TYPE ) )
+	/*wrong problem type*/
+	parse_error(EN3, no_lines);
+
+      if ( n <= 0  || m <= 0 )
+	/*wrong value of no of arcs or nodes*/
+	parse_error(EN4, no_lines);
+      break;
+
+    case 'a':                  /* no arcs are declared yet */
+      parse_error(EN16, no_lines);
+      break;
+
+    default:
+      parse_error(EN18, no_lines);
+      break;
+    }
+  }
+  if (!problem)                  /* no arcs declared, none read */
+    parse_error(EN19, no_lines);
+  if (p > end)                   /* the problem line was the last */
+    p = end;
+
+  /* allocating memory for the internal arrays; the graph follows
+     once the node range is known */
+  s.n = n;
+  s.m = m;
+  s.arcs      = (CSRArc*) malloc ( (m+1) * sizeof(CSRArc) );
+  s.arc_tail  = (long*) malloc ( m * sizeof(long) );
+  s.arc_first = (long*) calloc ( n+2, sizeof(long) );
+  /* arc_first [ 0 .. n+1 ] = 0 - initialized by calloc */
+  if ( s.arcs == NULL || s.arc_first == NULL || s.arc_tail == NULL )
+    /* memory is not allocated */
+    {
+      printf("Need %lld bytes for data and %lld bytes temp. data\n",
+	     ((long long) (n+1))*((long long) sizeof(long))+
+	     ((long long) (m+1))*((long long) sizeof(CSRArc)),
+	     ((long long) (n+m+2))*((long long) sizeof(long))+
+	     ((long long) (m+1))*((long long) sizeof(CSRArc)));
+      parse_error(EN6, no_lines);
+    }
+
+  /* cut the rest into chunks of whole lines */
+  chunks = threads > 1 ? (long) threads * CHUNKS_PER_THREAD : 1;
+  if (chunks > (long) (end - p) + 1)
+    chunks = (long) (end - p) + 1;
+  s.chunk = new GrChunk[chunks];
+  for (k = 0; k < chunks; k++) {
+    s.chunk[k].begin = k == 0 ? p : s.chunk[k - 1].end;
+    if (k == chunks - 1)
+      cut = end;
+    else {
+      cut = p + (end - p) * (k + 1) / chunks;
+      if (cut < s.chunk[k].begin)
+	cut = s.chunk[k].begin;
+      cut = line_end(cut, end);
+      if (cut < end)
+	cut++;                   /* just past the newline */
+    }
+    s.chunk[k].end = cut;
+  }
 
-printf ( "\nPrs%d: line %ld of input - %s\n", 
-         err_no, no_lines, err_message[err_no] );
+  poolRun(chunks, threads, count_chunk, &s);
+  lines = no_lines;
+  arcLines = 0;
+  for (k = 0; k < chunks; k++) {
+    s.chunk[k].firstLine = lines;
+    s.chunk[k].firstArc = arcLines;
+    lines += s.chunk[k].lines;
+    arcLines += s.chunk[k].arcLines;
+  }
 
-exit (1);
+  poolRun(chunks, threads, parse_chunk, &s);
+  node_min = 1;
+  node_max = 0;
+  for (k = 0; k < chunks; k++) {
+    if (s.chunk[k].err_no >= 0)
+      parse_error(s.chunk[k].err_no, s.chunk[k].errLine);
+    if (s.chunk[k].nodeMin < node_min) node_min = s.chunk[k].nodeMin;
+    if (s.chunk[k].nodeMax > node_max) node_max = s.chunk[k].nodeMax;
+  }
+  /* blocks of whole chunks, for the sort */
+  s.blocks = threads < chunks ? threads : chunks;
+  s.blockArc = new long[s.blocks + 1];
+  for (k = 0; k < s.blocks; k++)
+    s.blockArc[k] = s.chunk[chunks * k / s.blocks].firstArc;
+  s.blockArc[s.blocks] = m;
+  delete [] s.chunk;
+  munmap((void *) text, size);
+  close(fd);
+
+  if ( arcLines < m ) /* not enough arcs */
+    parse_error(EN19, lines);
+
+  /********** ordering arcs - counting sort by tail ***********/
+
+  s.node_min = node_min;
+  s.graph = csr_alloc(node_max - node_min + 1, m);
+  s.count = new long *[s.blocks];
+  s.ranges = threads;
+  s.rangeStart = new long[s.ranges];
+  poolRun(s.blocks, threads, count_tails, &s);
+  poolRun(s.ranges, threads, sum_tails, &s);
+  for (k = 0, i = 0; k < s.ranges; k++) {
+    t = s.rangeStart[k];
+    s.rangeStart[k] = i;
+    i += t;
+  }
+  poolRun(s.ranges, threads, place_tails, &s);
+  poolRun(s.blocks, threads, move_tails, &s);
+  s.arc_first[n + 1] = m;
+  for (k = 0; k < s.blocks; k++)
+    free(s.count[k]);
+  delete [] s.count;
+  delete [] s.blockArc;
+  delete [] s.rangeStart;
+
+  for ( i = node_min; i <= node_max + 1; i ++ )
+    s.graph->first[i - node_min] = s.arc_first[i];
+
+  /* assigning output values */
+  *m_ad = m;
+  *n_ad = node_max - node_min + 1;
+  *graph_ad = s.graph;
+
+  /* free internal memory */
+  free ( s.arcs ); free ( s.arc_first ); free ( s.arc_tail );
+
+  /* Uff! all is done */
+  return (0);
+}
 
+int parse_gr( long *n_ad, long *m_ad, CSRGraph **graph_ad, char *gName )
+{
+  return parse_gr_threads(n_ad, m_ad, graph_ad, gName, 1);
 }
 /* --------------------   end of parser  -------------------*/
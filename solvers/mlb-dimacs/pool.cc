@@ -0,0 +1,143 @@
+// pool.cc
+//     Work-stealing job pool (see pool.h).  A block is a range of
+//     jobs next .. last-1 under its own lock: the owner takes next,
+//     thieves lower last.  A thread only gives up once it finds
+//     every block empty; jobs it misses while they move belong to
+//     the thief, which runs them itself.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "pool.h"
+
+typedef struct PoolBlock {
+  pthread_mutex_t lock;
+  long next, last;
+} PoolBlock;
+
+typedef struct PoolState {
+  int threads;
+  PoolBlock *block;
+  PoolJob job;
+  void *arg;
+} PoolState;
+
+typedef struct PoolThread {
+  PoolState *pool;
+  int id;
+} PoolThread;
+
+// takes the next job of block b, or returns -1
+static long poolTake(PoolBlock *b)
+{
+  long job = -1;
+
+  pthread_mutex_lock(&b->lock);
+  if (b->next < b->last)
+    job = b->next++;
+  pthread_mutex_unlock(&b->lock);
+  return job;
+}
+
+// moves the back half of the biggest other block into block id
+static bool poolSteal(PoolState *pool, int id)
+{
+  PoolBlock *victim, *mine = pool->block + id;
+  long best, left, take, first;
+  int t, bestT;
+
+  for (;;) {
+    bestT = -1;
+    best = 0;
+    for (t = 0; t < pool->threads; t++) {
+      if (t == id)
+	continue;
+      pthread_mutex_lock(&pool->block[t].lock);
+      left = pool->block[t].last - pool->block[t].next;
+      pthread_mutex_unlock(&pool->block[t].lock);
+      if (left > best) {
+	best = left;
+	bestT = t;
+      }
+    }
+    if (bestT < 0)
+      return false;
+
+    // (no lock is held while taking another)
+    victim = pool->block + bestT;
+    pthread_mutex_lock(&victim->lock);
+    take = (victim->last - victim->next + 1) / 2;
+    victim->last -= take;
+    first = victim->last;
+    pthread_mutex_unlock(&victim->lock);
+    if (take > 0) {
+      pthread_mutex_lock(&mine->lock);
+      mine->next = first;
+      mine->last = first + take;
+      pthread_mutex_unlock(&mine->lock);
+      return true;
+    }
+    // the victim ran dry meanwhile; look again
+  }
+}
+
+static void *poolWork(void *arg)
+{
+  PoolThread *thread = (PoolThread *) arg;
+  PoolState *pool = thread->pool;
+  long job;
+
+  for (;;) {
+    while ((job = poolTake(pool->block + thread->id)) >= 0)
+      pool->job(job, thread->id, pool->arg);
+    if (!poolSteal(pool, thread->id))
+      break;
+  }
+  return NULL;
+}
+
+void poolRun(long count, int threads, PoolJob job, void *arg)
+{
+  PoolState pool;
+  PoolThread *thread;
+  pthread_t *tid;
+  long job0;
+  int t;
+
+  if (threads > count)
+    threads = (int) count;
+  if (threads <= 1) {
+    for (job0 = 0; job0 < count; job0++)
+      job(job0, 0, arg);
+    return;
+  }
+
+  pool.threads = threads;
+  pool.job = job;
+  pool.arg = arg;
+  pool.block = new PoolBlock[threads];
+  thread = new PoolThread[threads];
+  tid = new pthread_t[threads];
+  for (t = 0; t < threads; t++) {
+    pthread_mutex_init(&pool.block[t].lock, NULL);
+    pool.block[t].next = count * t / threads;
+    pool.block[t].last = count * (t + 1) / threads;
+    thread[t].pool = &pool;
+    thread[t].id = t;
+  }
+
+  for (t = 1; t < threads; t++)
+    if (pthread_create(tid + t, NULL, poolWork, thread + t) != 0) {
+      fprintf(stderr, "ERROR: can't start a query thread\n");
+      exit(1);
+    }
+  poolWork(thread);
+  for (t = 1; t < threads; t++)
+    pthread_join(tid[t], NULL);
+
+  for (t = 0; t < threads; t++)
+    pthread_mutex_destroy(&pool.block[t].lock);
+  delete [] pool.block;
+  delete [] thread;
+  delete [] tid;
+}
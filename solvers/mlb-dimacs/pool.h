@@ -0,0 +1,16 @@
+// pool.h
+//     A work-stealing pool for independent jobs 0 .. count-1.  Each
+//     thread starts with an equal block of consecutive jobs and
+//     takes them from the front; a thread whose block runs out
+//     steals the back half of the biggest block left.  The calling
+//     thread is thread 0.  Jobs must not depend on which thread runs
+//     them, only on the per-thread state indexed by thread.
+
+#ifndef POOL_H
+#define POOL_H
+
+typedef void (*PoolJob)(long job, int thread, void *arg);
+
+void poolRun(long count, int threads, PoolJob job, void *arg);
+
+#endif
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "radixheap.h"
+#include "nodearc.h"
+
+
+#define RADIX_NONE  (-1)      //key of a node not in the heap
+
+template <class KeyType>
+RadixHeap_Wrapper<KeyType>::RadixHeap_Wrapper(CSRGraph *graphGiven)
+{
+    long long maxArcLen;
+
+    graph = graphGiven;
+    if (sizeof(typename HeapNodeId<KeyType>::type) < sizeof(long) &&
+        graph->n > 4294967295LL) {
+        fprintf(stderr, "ERROR: too many nodes for 32-bit heap entries\n");
+        exit(1);
+    }
+    //bucket top-1 reaches last + 2^(top-1) - 1 >= 2 * maxArcLen,
+    //room for A* keys, which grow by up to twice an arc length
+    ArcLen(graph, NULL, &maxArcLen);
+    for (top = 2; (1LL << (top - 2)) <= maxArcLen && top < 62; top++)
+        ;
+    bucket = new std::vector<RadixEntry>[top + 1];
+    bound = new long long[top + 1];
+    key = new KeyType[graph->n];
+    for (long q = 0; q < graph->n; q++)
+        key[q] = RADIX_NONE;
+    Reset();
+}
+
+template <class KeyType>
+RadixHeap_Wrapper<KeyType>::~RadixHeap_Wrapper()
+{
+    delete [] bucket;
+    delete [] bound;
+    delete [] key;
+}
+
+//bucket ranges for last = 0
+template <class KeyType>
+void RadixHeap_Wrapper<KeyType>::Reset()
+{
+    last = 0;
+    for (int j = 0; j < top; j++)
+        bound[j] = (1LL << j) - 1;
+    bound[top] = VERY_FAR;
+}
+
+//files entry (k, v) in the lowest bucket whose range holds k, at
+//or below bucket from (bounds never decrease with the index)
+template <class KeyType>
+inline void RadixHeap_Wrapper<KeyType>::Insert(long v, long long k, int from)
+{
+    RadixEntry e;
+    int lo = 0, hi = from, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (bound[mid] >= k)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    e.key = (KeyType) k;
+    e.v = (typename HeapNodeId<KeyType>::type) v;
+    bucket[lo].push_back(e);
+}
+
+template <class KeyType>
+bool RadixHeap_Wrapper<KeyType>::Settle()
+{
+    long long min;
+    size_t q;
+    int i, j;
+
+    for (;;) {
+        //entries of bucket 0 all have key last; drop stale ones
+        while (!bucket[0].empty() &&
+               key[bucket[0].back().v] != bucket[0].back().key)
+            bucket[0].pop_back();
+        if (!bucket[0].empty())
+            return true;
+
+        for (i = 1; i <= top && bucket[i].empty(); i++)
+            ;
+        if (i > top)
+            return false;
+
+        min = VERY_FAR;
+        for (q = 0; q < bucket[i].size(); q++)
+            if (key[bucket[i][q].v] == bucket[i][q].key &&
+                bucket[i][q].key < min)
+                min = bucket[i][q].key;
+        if (min == VERY_FAR) {       //nothing but stale entries
+            bucket[i].clear();
+            continue;
+        }
+
+        //buckets 0 .. i-1 now split (bound[i-1], bound[i]] from min
+        //up; all of it fits, except for the overflow bucket
+        last = min;
+        bound[0] = last;
+        for (j = 1; j < i; j++) {
+            bound[j] = last + (1LL << j) - 1;
+            if (bound[j] > bound[i])
+                bound[j] = bound[i];
+        }
+        spill.swap(bucket[i]);
+        for (q = 0; q < spill.size(); q++)
+            if (key[spill[q].v] == spill[q].key)
+                Insert(spill[q].v, spill[q].key, i);
+        spill.clear();
+    }
+}
+
+template <class KeyType>
+void RadixHeap_Wrapper<KeyType>::Clear()
+{
+    for (int j = 0; j <= top; j++) {
+        for (size_t q = 0; q < bucket[j].size(); q++)
+            key[bucket[j][q].v] = RADIX_NONE;
+        bucket[j].clear();
+    }
+    Reset();
+}
+
+template <class KeyType>
+void RadixHeap_Wrapper<KeyType>::Push(long v, long long k)
+{
+    key[v] = (KeyType) k;
+    Insert(v, k, top);
+}
+
+template <class KeyType>
+void RadixHeap_Wrapper<KeyType>::Decrease(long v, long long k)
+{
+    key[v] = (KeyType) k;
+    Insert(v, k, top);
+}
+
+template <class KeyType>
+long RadixHeap_Wrapper<KeyType>::PopMin()
+{
+    long v;
+
+    if (!Settle())
+        return -1;
+    v = bucket[0].back().v;
+    bucket[0].pop_back();
+    key[v] = RADIX_NONE;
+    return v;
+}
+
+template <class KeyType>
+long long RadixHeap_Wrapper<KeyType>::MinKey()
+{
+    Settle();
+    return last;
+}
+
+template <class KeyType>
+bool RadixHeap_Wrapper<KeyType>::IsEmpty()
+{
+    return !Settle();
+}
+
+//the two key widths the driver chooses from
+template class RadixHeap_Wrapper<int>;
+template class RadixHeap_Wrapper<long long>;
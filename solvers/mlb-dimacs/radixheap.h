@@ -0,0 +1,63 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <vector>
+#include "nodearc.h"
+#include "csr.h"
+#include "sp.h" //get shortest path wrapper class
+
+#ifndef ulong
+typedef unsigned long ulong; // to get that extra bit
+#endif
+
+//Radix heap (Ahuja, Mehlhorn, Orlin and Tarjan) for monotone integer
+//keys: no key below the last one removed is ever inserted, as in
+//Dijkstra's algorithm and A* with consistent bounds.
+//
+//Bucket j holds keys in (bound[j-1], bound[j]]; bucket 0 holds only
+//the key last removed, bucket j > 0 at most 2^(j-1) keys, so
+//log C + 2 buckets cover every key up to last + C.  One more bucket
+//takes what lies beyond, e.g. shortcut lengths in a hierarchy.
+//When bucket 0 runs out, the lowest nonempty bucket is emptied into
+//the ones below it, whose ranges are reset around its minimum.
+//
+//There is no decrease-key structure: Decrease() adds another entry
+//and key[v] tells which entry of v is current; the others are
+//dropped when their bucket is emptied.  KeyType is int or long long
+//as for the other heaps, and picks the width of the node id in an
+//entry (HeapNodeId, csr.h); instantiations live in radixheap.cc.
+template <class KeyType>
+class RadixHeap_Wrapper{
+public:
+    typedef struct RadixEntry {
+        KeyType key;
+        typename HeapNodeId<KeyType>::type v;
+    } RadixEntry;
+private:
+    CSRGraph *graph;  //shared, read-only
+    int top;          //overflow bucket; buckets 0 .. top
+    std::vector<RadixEntry> *bucket;
+    long long *bound; //largest key of each bucket
+    long long last;   //key last removed
+    KeyType *key;     //key[v] of a queued node, or -1
+    std::vector<RadixEntry> spill;  //bucket being emptied
+
+    void Reset();
+    void Insert(long v, long long k, int from);
+    bool Settle();    //moves the minimum to bucket 0; false if empty
+public:
+    RadixHeap_Wrapper(CSRGraph *graph);
+
+    ~RadixHeap_Wrapper();
+
+    //queue interface the searches run on (HeapEngine in engine.cc,
+    //bidir.h and the others); v is a node index, keys are distances
+    void Clear();
+    void Push(long v, long long key);
+    void Decrease(long v, long long key);
+    long PopMin();             //-1 if empty
+    long long MinKey();        //must not be empty
+    bool IsEmpty();
+};
+
+#endif
@@ -0,0 +1,290 @@
+// reorder.cc
+//     Node orders for locality (see reorder.h).  bfs and rcm work on
+//     the graph made symmetric, so that a node's predecessors count
+//     as its neighbors too; hilbert only looks at the coordinates.
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "reorder.h"
+
+#define REORDER_SWEEPS      8          // bound on the rcm root search
+#define HILBERT_BITS        16         // per coordinate
+
+int reorderFindMethod(const char *name)
+{
+  if (strcmp(name, "bfs") == 0)     return REORDER_BFS;
+  if (strcmp(name, "rcm") == 0)     return REORDER_RCM;
+  if (strcmp(name, "hilbert") == 0) return REORDER_HILBERT;
+  return 0;
+}
+
+const char *reorderMethodName(int method)
+{
+  switch (method) {
+  case REORDER_BFS:     return "bfs";
+  case REORDER_RCM:     return "rcm";
+  case REORDER_HILBERT: return "hilbert";
+  case 0:               return "input";
+  }
+  return "unknown";
+}
+
+// count zeroed elements of size bytes
+static void *reorderAlloc(long count, size_t size)
+{
+  void *a = calloc(count > 0 ? count : 1, size);
+
+  if (a == NULL) {
+    fprintf(stderr, "ERROR: can't allocate the node order\n");
+    exit(1);
+  }
+  return a;
+}
+
+// the graph with every arc also taken backward: the neighbors of v
+// are adj[first[v]] .. adj[first[v+1]-1], heads first, then tails
+typedef struct SymGraph {
+  long n;
+  long *first;
+  long *adj;
+} SymGraph;
+
+static void reorderSym(CSRGraph *graph, SymGraph *sym)
+{
+  long n = graph->n, m = graph->m, v, a, *fill;
+
+  sym->n = n;
+  sym->first = (long *) reorderAlloc(n + 1, sizeof(long));
+  sym->adj = (long *) reorderAlloc(2 * m, sizeof(long));
+  fill = (long *) reorderAlloc(n, sizeof(long));
+
+  for (a = 0; a < m; a++)
+    fill[csr_head(graph, a)]++;
+  sym->first[0] = 0;
+  for (v = 0; v < n; v++)
+    sym->first[v + 1] = sym->first[v] +
+      (graph->first[v + 1] - graph->first[v]) + fill[v];
+  for (v = 0; v < n; v++) {
+    fill[v] = sym->first[v];
+    for (a = graph->first[v]; a < graph->first[v + 1]; a++)
+      sym->adj[fill[v]++] = csr_head(graph, a);
+  }
+  for (v = 0; v < n; v++)
+    for (a = graph->first[v]; a < graph->first[v + 1]; a++)
+      sym->adj[fill[csr_head(graph, a)]++] = v;
+  free(fill);
+}
+
+// orders nodes by increasing degree, then index
+class ByDegree {
+ private:
+   const long *first;
+ public:
+   ByDegree(const long *firstGiven)  { first = firstGiven; }
+   bool operator()(long v, long w) const
+   {
+     long dv = first[v + 1] - first[v], dw = first[w + 1] - first[w];
+
+     return dv < dw || (dv == dw && v < w);
+   }
+};
+
+//-------------------------------------------------------------
+// reorderSweep()
+//     Breadth-first search from root over the nodes not yet seen,
+//     appending them to order from *count on; order doubles as the
+//     queue.  With byDegree the new neighbors of each node enter by
+//     increasing degree.  With undo the nodes are unmarked again and
+//     *count is left as it was.  Returns a node of least degree in
+//     the last level, and its level in *depth.
+//-------------------------------------------------------------
+
+static long reorderSweep(SymGraph *sym, long root, char *seen, long *order,
+			 long *count, bool byDegree, bool undo, long *depth)
+{
+  long head = *count, tail = *count, levelEnd, last, start, v, a, w;
+  long deg, bestDeg = -1, best = root;
+
+  order[tail++] = root;
+  seen[root] = 1;
+  *depth = 0;
+  last = head;
+  levelEnd = tail;
+  while (head < tail) {
+    if (head == levelEnd) {    // the next level starts here
+      last = head;
+      levelEnd = tail;
+      (*depth)++;
+    }
+    v = order[head++];
+    start = tail;
+    for (a = sym->first[v]; a < sym->first[v + 1]; a++) {
+      w = sym->adj[a];
+      if (!seen[w]) {
+	seen[w] = 1;
+	order[tail++] = w;
+      }
+    }
+    if (byDegree && tail - start > 1)
+      std::sort(order + start, order + tail, ByDegree(sym->first));
+  }
+  for (a = last; a < tail; a++) {
+    deg = sym->first[order[a] + 1] - sym->first[order[a]];
+    if (bestDeg < 0 || deg < bestDeg) {
+      bestDeg = deg;
+      best = order[a];
+    }
+  }
+  if (undo)
+    for (a = *count; a < tail; a++)
+      seen[order[a]] = 0;
+  else
+    *count = tail;
+  return best;
+}
+
+// bfs and rcm: order[i] is the node that gets index i
+static void reorderGraphSearch(CSRGraph *graph, int method, long *order)
+{
+  SymGraph sym;
+  char *seen = (char *) reorderAlloc(graph->n, 1);
+  long n = graph->n, count = 0, root, next, v, depth, newDepth, i, t;
+
+  reorderSym(graph, &sym);
+  for (v = 0; v < n; v++) {
+    if (seen[v])
+      continue;
+    root = v;
+    if (method == REORDER_RCM) {
+      // George and Liu: restart from a low-degree node of the last
+      // level while that makes the search deeper
+      next = reorderSweep(&sym, root, seen, order, &count, false, true,
+			  &depth);
+      for (i = 0; i < REORDER_SWEEPS && next != root; i++) {
+	t = reorderSweep(&sym, next, seen, order, &count, false, true,
+			 &newDepth);
+	if (newDepth <= depth)
+	  break;
+	root = next;
+	next = t;
+	depth = newDepth;
+      }
+    }
+    reorderSweep(&sym, root, seen, order, &count, method == REORDER_RCM,
+		 false, &depth);
+  }
+  if (method == REORDER_RCM)
+    std::reverse(order, order + n);
+
+  free(seen);
+  free(sym.first);
+  free(sym.adj);
+}
+
+// position of (x, y) along the Hilbert curve filling the square of
+// side 2^HILBERT_BITS
+static unsigned int hilbertIndex(unsigned int x, unsigned int y)
+{
+  unsigned int s, rx, ry, t, d = 0;
+
+  for (s = 1u << (HILBERT_BITS - 1); s > 0; s >>= 1) {
+    rx = (x & s) != 0;
+    ry = (y & s) != 0;
+    d += s * s * ((3 * rx) ^ ry);
+    if (ry == 0) {             // rotate the quadrant
+      if (rx == 1) {
+	x = s - 1 - x;
+	y = s - 1 - y;
+      }
+      t = x;
+      x = y;
+      y = t;
+    }
+  }
+  return d;
+}
+
+static void reorderHilbert(CSRGraph *graph, long *order)
+{
+  std::vector<std::pair<unsigned int, long> > key(graph->n);
+  const double side = (double) ((1u << HILBERT_BITS) - 1);
+  long n = graph->n, minX, maxX, minY, maxY, v;
+  double scale;
+
+  if (graph->x == NULL || graph->y == NULL) {
+    fprintf(stderr, "ERROR: hilbert order needs node coordinates\n");
+    exit(1);
+  }
+  minX = maxX = graph->x[0];
+  minY = maxY = graph->y[0];
+  for (v = 1; v < n; v++) {
+    minX = std::min(minX, graph->x[v]);
+    maxX = std::max(maxX, graph->x[v]);
+    minY = std::min(minY, graph->y[v]);
+    maxY = std::max(maxY, graph->y[v]);
+  }
+  // one scale for both axes keeps the cells square
+  scale = side / (double) std::max(std::max(maxX - minX, maxY - minY), 1L);
+  for (v = 0; v < n; v++) {
+    key[v].first = hilbertIndex((unsigned int) ((graph->x[v] - minX) * scale),
+				(unsigned int) ((graph->y[v] - minY) * scale));
+    key[v].second = v;
+  }
+  std::sort(key.begin(), key.end());
+  for (v = 0; v < n; v++)
+    order[v] = key[v].second;
+}
+
+CSRGraph *reorderGraph(CSRGraph *graph, int method,
+		       long **newId_ad, long **oldId_ad)
+{
+  long n = graph->n, v, a, k = 0;
+  long *oldId = (long *) reorderAlloc(n, sizeof(long));
+  long *newId = (long *) reorderAlloc(n, sizeof(long));
+  CSRGraph *g;
+
+  if (method == REORDER_HILBERT)
+    reorderHilbert(graph, oldId);
+  else
+    reorderGraphSearch(graph, method, oldId);
+  for (v = 0; v < n; v++)
+    newId[oldId[v]] = v;
+
+  g = csr_alloc(n, graph->m, graph->arcs32 != NULL);    // same layout
+  for (v = 0; v < n; v++) {
+    g->first[v] = k;
+    for (a = graph->first[oldId[v]]; a < graph->first[oldId[v] + 1]; a++) {
+      if (g->arcs32 != NULL) {
+	g->arcs32[k].len = graph->arcs32[a].len;
+	g->arcs32[k].head = (unsigned int) newId[graph->arcs32[a].head];
+      }
+      else {
+	g->arcs[k].len = graph->arcs[a].len;
+	g->arcs[k].head = newId[graph->arcs[a].head];
+      }
+      k++;
+    }
+  }
+  g->first[n] = k;
+  if (graph->x != NULL && graph->y != NULL) {
+    g->x = (long *) reorderAlloc(n, sizeof(long));
+    g->y = (long *) reorderAlloc(n, sizeof(long));
+    for (v = 0; v < n; v++) {
+      g->x[v] = graph->x[oldId[v]];
+      g->y[v] = graph->y[oldId[v]];
+    }
+  }
+  g->lonLat = graph->lonLat;
+  g->order = method;
+
+  *newId_ad = newId;
+  if (oldId_ad != NULL)
+    *oldId_ad = oldId;
+  else
+    free(oldId);
+  return g;
+}
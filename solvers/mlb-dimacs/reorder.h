@@ -0,0 +1,43 @@
+// reorder.h
+//     Renumbers the nodes of a graph so that nodes near each other in
+//     the graph get nearby indices.  Generated graphs have their node
+//     ids shuffled on purpose and road graphs come in arbitrary
+//     order, so a search otherwise touches labels (and arc lists)
+//     scattered over the whole Node array.  The orders are
+//
+//       bfs      breadth-first over the arcs taken in both directions,
+//                from node 0 and then from the first node left in
+//                each further component
+//       rcm      reverse Cuthill-McKee: breadth-first from a
+//                pseudo-peripheral node of each component, the new
+//                neighbors of a node taken by increasing degree, and
+//                the whole order reversed
+//       hilbert  position along a Hilbert curve over the node
+//                coordinates (needs them)
+//
+//     The graph is rebuilt, coordinates included, in the new
+//     numbering, which is what all searches and preprocessing (and
+//     the files it writes, stamped with the order: csr_check_stamp)
+//     then use.  The permutation is kept by the
+//     caller to translate node ids at the edges: queries come in and
+//     results go out in the original numbering.
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "csr.h"
+
+#define REORDER_BFS         1          // node orders
+#define REORDER_RCM         2
+#define REORDER_HILBERT     3
+
+int reorderFindMethod(const char *name);   // 0 if unknown
+const char *reorderMethodName(int method);
+// graph renumbered by method, with its coordinates and lonLat, as a
+// new graph; graph itself is left alone.  (*newId_ad)[v] is the new
+// index of node v, and *oldId_ad (unless oldId_ad is NULL) the
+// inverse; both have n entries, for the caller to free.
+CSRGraph *reorderGraph(CSRGraph *graph, int method,
+		       long **newId_ad, long **oldId_ad);
+
+#endif
@@ -8,12 +8,20 @@
 #include "sp.h"
 #include "assert.h"
 
-#define NEXT(pNode)          ( (pNode)->sBckInfo.next )
-#define PREV(pNode)          ( (pNode)->sBckInfo.prev )
-#define BUCKET(pNode)        ((Bucket *)((pNode)->sBckInfo.bucket))
-#ifndef MLB
-#define CALIBER(pNode)       ( (pNode)->sBckInfo.caliber )
-#endif
+// per-node fields; members, so only for use inside SmartQ
+#define LINK(pNode)          ( rgLink[(pNode) - nodes] )
+#define NEXT(pNode)          ( LINK(pNode).next )
+#define PREV(pNode)          ( LINK(pNode).prev )
+#define BUCKET(pNode)        ( LINK(pNode).bucket )
+#define CALIBER(pNode)       ( rgCaliber[(pNode) - nodes] )
+
+// occupancy bitmaps: one bit per bucket, 64 buckets to a word
+#define OCC_WORDS(cBins)     ( ((cBins) + 63) >> 6 )
+#define OCC_SET(pBck)        ( (pBck)->pLevel->occupied[BIN(pBck) >> 6] |= \
+			       1ULL << (BIN(pBck) & 63) )
+#define OCC_CLEAR(pBck)      ( (pBck)->pLevel->occupied[BIN(pBck) >> 6] &= \
+			       ~(1ULL << (BIN(pBck) & 63)) )
+#define BIN(pBck)            ( (ulong) ((pBck) - (pBck)->pLevel->rgBin) )
 
 #ifdef ALLSTATS                        // expensive stats to calculate
 #define EMPTY_BUCKET              statEmpty++
@@ -46,25 +54,24 @@
 //        Init() resets indices.  It must be done each time we
 //     want to use the buckets, as opposed to Bucket(), which
 //     allocates memory and need only be done once.
+//        reInit() only visits the buckets the bitmaps mark as
+//     nonempty, which after a single-pair search may be a few.
 //------------------------------------------------------------
 
 void SmartQ::Init()
 {
    Level *pLevel;
-   ulong iBucket;
+   ulong iBucket, cBins;
 
-#ifndef MLB
    F->Clear();
-#endif
    for ( pLevel = rgLevels; pLevel <= topLevel; pLevel++ ) {
      pLevel->cNodes = 0;
      pLevel->pBucket = pLevel->rgBin;              // curr bucket is leftmost
-     if (pLevel != topLevel)
-       for (iBucket = 0; iBucket < delta; iBucket++)
-	 pLevel->rgBin[iBucket].pNode = NULL;
-     else
-       for (iBucket = 0; iBucket < topDelta; iBucket++)
-	 pLevel->rgBin[iBucket].pNode = NULL;
+     cBins = Bins(pLevel);
+     for (iBucket = 0; iBucket < cBins; iBucket++)
+       pLevel->rgBin[iBucket].pNode = NULL;
+     for (iBucket = 0; iBucket < OCC_WORDS(cBins); iBucket++)
+       pLevel->occupied[iBucket] = 0;
    }
    minLevel = topLevel;
 
@@ -79,59 +86,57 @@ void SmartQ::Init()
 void SmartQ::reInit()
 {
    Level *pLevel;
-   ulong iBucket;
+   ulong iWord, cWords;
+   unsigned long long bits;
 
-#ifndef MLB
    F->Clear();
-#endif
    for ( pLevel = rgLevels; pLevel <= topLevel; pLevel++ ) {
      pLevel->cNodes = 0;
      pLevel->pBucket = pLevel->rgBin;              // curr bucket is leftmost
-     if (pLevel != topLevel)
-       for (iBucket = 0; iBucket < delta; iBucket++)
-	 pLevel->rgBin[iBucket].pNode = NULL;
-     else
-       for (iBucket = 0; iBucket < topDelta; iBucket++)
-	 pLevel->rgBin[iBucket].pNode = NULL;
+     cWords = OCC_WORDS(Bins(pLevel));
+     for (iWord = 0; iWord < cWords; iWord++)
+       for (bits = pLevel->occupied[iWord]; bits; bits &= bits - 1)
+	 pLevel->rgBin[(iWord << 6) + __builtin_ctzll(bits)].pNode = NULL;
+     for (iWord = 0; iWord < cWords; iWord++)
+       pLevel->occupied[iWord] = 0;
    }
    minLevel = topLevel;
 
 }
 
 SmartQ::SmartQ(long long *pMinArcLen, long long *pMaxArcLen, 
-	       ulong cLevels, ulong logD, long n, Node *nodes)
+	       ulong cLevels, ulong logD, CSRGraph *graphGiven,
+	       Node *nodesGiven, bool useCaliber)
 {
   ulong i;
   Level *pLevel;
-#ifndef MLB
-  Arc *lastArc, *arc;
-  Node *currentNode;
-#endif
+  long n;
   long long maxArcLen, minArcLen;
   ulong logMax;
 
   maxArcLen = *pMaxArcLen;
   minArcLen = *pMinArcLen;
   logDelta = logD;
+  graph = graphGiven;
+  nodes = nodesGiven;
+  caliber = useCaliber;
+  n = graph->n;
 
   F = new Stack(n);
-#ifndef MLB  
-  // compute calibers
-  for (currentNode = nodes; currentNode < nodes + n; currentNode++)
-    CALIBER(currentNode) = VERY_FAR;
-  
-  for (currentNode = nodes; currentNode < nodes + n; currentNode++) {
-    lastArc = (currentNode + 1)->first - 1;
-    for (arc = currentNode->first; arc <= lastArc; arc++) 
-      if (CALIBER(arc->head) > arc->len)
-	CALIBER(arc->head) = arc->len;
+  rgLink = new BucketLink[n];
+  rgCaliber = NULL;
+  if (caliber) {
+    // calibers are computed once per graph and shared
+    csr_add_calibers(graph);
+    rgCaliber = graph->caliber;
   }
-#endif
   
   // compute logBottom = floor(log_2(minArcLen))
 
+  // (bottom buckets must be no wider than minArcLen, or a node could
+  //  be removed before a bucket-mate that still improves it)
   logBottom = 0;
-  while ((long long) 1 << logBottom < minArcLen)
+  while ((long long) 2 << logBottom <= minArcLen)
     logBottom++;
 
   // exactly one of #levels, logDelta is specified; compute the other
@@ -192,11 +197,10 @@ SmartQ::SmartQ(long long *pMinArcLen, long long *pMaxArcLen,
       }
     }
 
-#ifndef MLB
-  logTopDelta = logDelta + 2;
-#else
-  logTopDelta = logDelta + 1;
-#endif
+  if (caliber)
+    logTopDelta = logDelta + 2;
+  else
+    logTopDelta = logDelta + 1;
 
   relBitMask = 0;
   for (i = 1; i <= (cLevels-1) * logDelta + logTopDelta; i++)
@@ -212,6 +216,7 @@ SmartQ::SmartQ(long long *pMinArcLen, long long *pMaxArcLen,
 
   for (pLevel = rgLevels; pLevel < topLevel; pLevel++) {
     pLevel->rgBin = new Bucket[delta];
+    pLevel->occupied = new unsigned long long[OCC_WORDS(delta)];
     for (i = 0; i < delta; i++)
       pLevel->rgBin[i].pLevel = pLevel;   // store level info
     // do shifts and masks
@@ -224,6 +229,7 @@ SmartQ::SmartQ(long long *pMinArcLen, long long *pMaxArcLen,
   }
   // now the top level
   topLevel->rgBin = new Bucket[topDelta];
+  topLevel->occupied = new unsigned long long[OCC_WORDS(topDelta)];
   for (i = 0; i < topDelta; i++)
     topLevel->rgBin[i].pLevel = topLevel;   // store level info
   topLevel->digShift = logBottom + logDelta * (topLevel - rgLevels);
@@ -238,10 +244,13 @@ SmartQ::~SmartQ()
 {
    Level *pLevel;
 
-   for ( pLevel = rgLevels; pLevel <= topLevel; pLevel++ )
-      delete pLevel->rgBin;
-   delete rgLevels;
-   F->~Stack();
+   for ( pLevel = rgLevels; pLevel <= topLevel; pLevel++ ) {
+      delete [] pLevel->rgBin;
+      delete [] pLevel->occupied;
+   }
+   delete [] rgLevels;
+   delete F;
+   delete [] rgLink;
 }
 
 //------------------------------------------------------------
@@ -299,11 +308,11 @@ Node *SmartQ::Insert(Node *node, Bucket *bckNew)
   INSERT_TO_BUCKET;
   //   printf(">>>Inserting d %lld lev %d buck %d\n",
   //   	 node->dist, bckNew->pLevel - rgLevels, bckNew - bckNew->pLevel->rgBin);
-  node->sBckInfo.bucket = bckNew; // where we live, now
-  //  BUCKET(node) = bckNew;          // where we live, now
+  BUCKET(node) = bckNew;          // where we live, now
   if ( bckNew->pNode == NULL )    // we're the first one in the bucket
     {
       bckNew->pNode = NEXT(node) = PREV(node) = node;    // a cycle of length 1
+      OCC_SET(bckNew);
     }
   else                            // insert us in cycle, before first
     {
@@ -332,6 +341,7 @@ Node *SmartQ::Delete(Node *node, Bucket *bckOld)
   if ( NEXT(node) == node )    // we're the last one in the bucket
     {
       bckOld->pNode = NULL;     // (nodes loop around to form a cycle)
+      OCC_CLEAR(bckOld);
     }
   else                         // update people around us
     {
@@ -387,6 +397,7 @@ Node *SmartQ::SortBucket(Level *pLevel)
   // sort
   pNode = pLevel->pBucket->pNode;
   pLevel->pBucket->pNode = NULL;          // remember to bookkeep now
+  OCC_CLEAR(pLevel->pBucket);
   for (;
        pNode;
        pNode = nextNode) {
@@ -395,27 +406,53 @@ Node *SmartQ::SortBucket(Level *pLevel)
     pLevel->cNodes--;
     EXPANDED_NODE;               // we've moved another node
     if (pNode == ans) continue;  // do not insert answer
-#ifndef MLB    
-    if (pNode->dist <= mu + CALIBER(pNode)) {
+    if (caliber && pNode->dist <= mu + CALIBER(pNode)) {
       pNode->where = IN_F;
       F->Push(pNode);
     }
     else {
-#endif
       assert(pLevel > rgLevels);
       bckNew = DistToBucket(&(pNode->dist),
 			    DistToLevel(&(pNode->dist)));
       assert(bckNew->pLevel < pLevel);
       Insert(pNode, bckNew);     // Insert increases cNodes
-#ifndef MLB
     }
-#endif
   }
 
   assert(ans != NULL);
   return ans;
 }
 
+//------------------------------------------------------------
+// SmartQ::NextBucket()
+//   The first nonempty bucket at or after pLevel->pBucket, found
+//   a word of the occupancy bitmap at a time.  Below the top,
+//   the buckets past the current one hold the rest of the level;
+//   at the top they run on circularly, so the search wraps.
+//   The level must not be empty.
+//------------------------------------------------------------
+
+Bucket *SmartQ::NextBucket(Level *pLevel)
+{
+  ulong iBin, iWord, cWords;
+  unsigned long long bits;
+
+  assert(pLevel->cNodes > 0);
+  cWords = OCC_WORDS(Bins(pLevel));
+  iBin = BIN(pLevel->pBucket);
+  iWord = iBin >> 6;
+  bits = pLevel->occupied[iWord] & (~0ULL << (iBin & 63));
+  while (bits == 0) {
+    EMPTY_BUCKET;
+    if (++iWord == cWords) {
+      assert(pLevel == topLevel);
+      iWord = 0;
+    }
+    bits = pLevel->occupied[iWord];
+  }
+  return pLevel->rgBin + (iWord << 6) + __builtin_ctzll(bits);
+}
+
 //------------------------------------------------------------
 // SmartQ::RemoveMin()
 //   Find the lowest nonempty level and the fist nonempty bucket at
@@ -445,22 +482,9 @@ Node *SmartQ::RemoveMin()
 
   // find first nonempty bucket
   if (pLevel->pBucket->pNode == NULL) {
-    if (pLevel < topLevel) {
-      assert(DistToBucket(&mu,  pLevel) == pLevel->pBucket);
-      do {
-	EMPTY_BUCKET;
-	(pLevel->pBucket)++;
-      } while (pLevel->pBucket->pNode == NULL);
-      assert(pLevel->pBucket - pLevel->rgBin < (long) delta);
-    }
-    else
-      do {
-	EMPTY_BUCKET;
-	if (pLevel->pBucket - pLevel->rgBin < (long) topDelta - 1)
-	  (pLevel->pBucket)++;
-	else
-	  pLevel->pBucket = pLevel->rgBin;
-      } while (pLevel->pBucket->pNode == NULL);
+    assert(pLevel == topLevel ||
+	   DistToBucket(&mu,  pLevel) == pLevel->pBucket);
+    pLevel->pBucket = NextBucket(pLevel);
   }
   
   assert(pLevel->pBucket != NULL);
@@ -482,7 +506,7 @@ Node *SmartQ::RemoveMin()
 //------------------------------------------------------------
 // SmartQ::PrintStats()
 //     Prints stats specific to bucket implementation: how many
-//     empty buckets we scan over, how many nodes we move from
+//     bitmap words with no nonempty bucket we scan over, how many nodes we move from
 //     one level to another, how many buckets we expand,
 //     how many nodes, when put into a bucket, are the first
 //     in the bucket, and how many nodes, when removed from
@@ -492,14 +516,17 @@ Node *SmartQ::RemoveMin()
 
 void SmartQ::PrintStats(long tries)
 {
+   fprintf(stderr, "c Levels: %23lu       Log delta: %17lu\n",
+	   Levels(), logDelta);
 #ifdef ALLSTATS
-   printf("c Empty Buckets (ave): %10lld     \n", statEmpty);
-   printf("c Expanded Nodes(ave): %12.1f     Expanded Buckets (ave): %8.1f\n",
-	  (float) statExpandedNodes/ (float) tries, 
-	  (float) statExpandedBuckets/ (float) tries);
-   printf("c Bucket inserts (ave): %11.1f     Position evals (ave): %10.1f\n",
-	  (float) statInsert/ (float) tries, 
-	  (float) statPosEval/ (float) tries);
+   fprintf(stderr, "c Empty Words (ave): %12.1f     \n",
+	   (float) statEmpty/ (float) tries);
+   fprintf(stderr, "c Expanded Nodes(ave): %12.1f     Expanded Buckets (ave): %8.1f\n",
+	   (float) statExpandedNodes/ (float) tries, 
+	   (float) statExpandedBuckets/ (float) tries);
+   fprintf(stderr, "c Bucket inserts (ave): %11.1f     Position evals (ave): %10.1f\n",
+	   (float) statInsert/ (float) tries, 
+	   (float) statPosEval/ (float) tries);
 #endif
 }
 
@@ -507,45 +534,43 @@ void SmartQ::PrintStats(long tries)
    into the set F of nodes with exact distances instead of the buckets.
    Nodes in F have priority when the next node to be scanned is chosen.
 
-   Multi-level buckets do not use F.
+   Multi-level buckets (MLB) do not use F.
 
-   For single-pair, dijkstra returns false if the sink is not NULL and 
-   is not reached
+   For single-pair (SinglePair), sink is not NULL and dijkstra
+   returns false if the sink is not reached.  Both choices, and the
+   arc layout (csr.h), are template parameters so each variant gets
+   its own scan loop.
  */
 
-#ifdef SINGLE_PAIR
-bool SmartQ::dijkstra(Node *source, Node *sink, SP *sp)
-#else
-void SmartQ::dijkstra(Node *source, SP *sp)
-#endif
+template <bool MLB, bool SinglePair, class Arc>
+bool SmartQ::dijkstra(Node *source, Node *sink, SP *sp, const Arc *arcs)
 {
    Node *currentNode, *newNode;   // newNode is beyond our current range
-   Arc *arc, *lastArc;            // last arc of the current node
+   const Arc *arc, *lastArc;      // last arc of the current node
    Bucket *bckOld, *bckNew;
-#ifdef SINGLE_PAIR
-   bool reached;
-#endif
+   long *parent = sp->getParents();
+   bool reached = true;
 
+   assert(MLB != caliber);
+   assert(nodes == sp->getNodes());
    reInit();                        // reset indices
    mu = 0;
    sp->curTime++;
    source->tStamp = sp->curTime;
 
-#ifdef SINGLE_PAIR
-   if (source == sink) return(true);
-   if (sink == NULL)
-     reached = true;
-   else
+   if (SinglePair) {
+     if (source == sink) return(true);
      reached = false;
-#endif
+   }
 
-#ifndef MLB
-   source->where = IN_F;
-   F->Push(source);
-#else
-   bckNew = DistToBucket(&(source->dist), DistToLevel(&(source->dist)));
-   Insert(source, bckNew);
-#endif
+   if (!MLB) {
+     source->where = IN_F;
+     F->Push(source);
+   }
+   else {
+     bckNew = DistToBucket(&(source->dist), DistToLevel(&(source->dist)));
+     Insert(source, bckNew);
+   }
 
    do
    {
@@ -555,27 +580,25 @@ void SmartQ::dijkstra(Node *source, SP *sp)
 	 assert(F->IsEmpty());
 	 break;
        }
-#ifdef SINGLE_PAIR
        // check if done
-       if (currentNode == sink) {
+       if (SinglePair && currentNode == sink) {
 	 reached = true;
 	 break;
        }
-#endif
      }
      else {
        currentNode = (Node *) F->Pop();
-#ifdef SINGLE_PAIR
-       // check if done
-       if (currentNode == sink) {
-	 reached = true;
-	 break;
+       if (SinglePair) {
+	 // check if done
+	 if (currentNode == sink) {
+	   reached = true;
+	   break;
+	 }
+	 // do not need to search past sink distance
+	 if ((sink->tStamp == sp->curTime) &&
+	     (currentNode->dist >= sink->dist))
+	   continue;
        }
-       // do not need to search past sink distance
-       if ((sink != NULL) && (sink->tStamp == sp->curTime) &&
-	   (currentNode->dist >= sink->dist))
-	 continue;
-#endif
      }
      
      //     printf(">>>scanning d %lld (mu %lld)\n", currentNode->dist, mu);
@@ -583,43 +606,44 @@ void SmartQ::dijkstra(Node *source, SP *sp)
      assert(currentNode->tStamp == sp->curTime);
      currentNode->where = IN_SCANNED;
      // scan node
-     lastArc = (currentNode + 1)->first - 1;
-     for ( arc = currentNode->first; arc <= lastArc; arc++ )
+     lastArc = arcs + graph->first[currentNode - nodes + 1];
+     for ( arc = arcs + graph->first[currentNode - nodes];
+	   arc < lastArc; arc++ )
       {
-	 newNode = arc->head;                      // where our arc ends up
+	 newNode = nodes + arc->head;              // where our arc ends up
 	 if (newNode->tStamp != sp->curTime)
 	   sp->initNode(newNode);
 	 if ( currentNode->dist + arc->len < newNode->dist )
 	 {
 	   assert(newNode->where != IN_F);
 	   assert(newNode->where != IN_SCANNED);
-	   bckOld = BUCKET(newNode);       // NULL if node not in a bucket
+	   // NULL if node not in a bucket
+	   bckOld = InBucket(newNode) ? BUCKET(newNode) : NULL;
 	   newNode->dist = currentNode->dist + arc->len; // we're shorter
-	   newNode->parent = currentNode;                // update sp tree
+	   parent[arc->head] = currentNode - nodes;      // update sp tree
 
-#ifndef MLB
-	   if (newNode->dist <= mu + CALIBER(newNode)) {
+	   if (!MLB && newNode->dist <= mu + CALIBER(newNode)) {
 	     // the node must go to F
 	     if ( InBucket(newNode) ) {
 
 	       Delete(newNode, bckOld);
 	     }
-#ifdef SINGLE_PAIR
-	     if (newNode == sink) {
-	       reached = true;
-	       break;
+	     if (SinglePair) {
+	       // a node going to F has its exact distance
+	       if (newNode == sink) {
+		 reached = true;
+		 break;
+	       }
+	       // do not need to search past sink distance
+	       if ((sink->tStamp == sp->curTime) &&
+		   (newNode->dist >= sink->dist))
+		 continue;
 	     }
-	     // do not need to search past sink distance
-	     if ((sink != NULL) && (sink->tStamp == sp->curTime) &&
-		 (newNode->dist >= sink->dist))
-	       continue;
-#endif
 	     // note that newNode cannot be in F
 	     newNode->where = IN_F;
 	     F->Push(newNode);
 	   }
 	   else {
-#endif
 	     // relocate the node in B if needed
 	     bckNew = DistToBucket(&(newNode->dist),
 				   DistToLevel(&(newNode->dist)));
@@ -630,15 +654,22 @@ void SmartQ::dijkstra(Node *source, SP *sp)
 	       Insert(newNode, bckNew);
 	       sp->cUpdates++;
 	     }
-#ifndef MLB
 	   }
-#endif
 	 }
       }
+     if (SinglePair && reached)
+       break;
    } while (1);
 
-#ifdef SINGLE_PAIR
    return(reached);
-#endif
 }
 
+// the variants the engine registry (engine.cc) instantiates
+template bool SmartQ::dijkstra<false, false>(Node *, Node *, SP *, const CSRArc *);
+template bool SmartQ::dijkstra<false, true>(Node *, Node *, SP *, const CSRArc *);
+template bool SmartQ::dijkstra<true, false>(Node *, Node *, SP *, const CSRArc *);
+template bool SmartQ::dijkstra<true, true>(Node *, Node *, SP *, const CSRArc *);
+template bool SmartQ::dijkstra<false, false>(Node *, Node *, SP *, const CSRArc32 *);
+template bool SmartQ::dijkstra<false, true>(Node *, Node *, SP *, const CSRArc32 *);
+template bool SmartQ::dijkstra<true, false>(Node *, Node *, SP *, const CSRArc32 *);
+template bool SmartQ::dijkstra<true, true>(Node *, Node *, SP *, const CSRArc32 *);
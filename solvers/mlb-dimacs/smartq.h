@@ -6,6 +6,7 @@
 #define SMARTQ_H
 
 #include "nodearc.h"         // dfn of node and arc
+#include "csr.h"             // the graph we scan
 
 #ifndef ulong
 typedef unsigned long ulong; // to get that extra bit
@@ -20,10 +21,20 @@ typedef struct Bucket {
    Level *pLevel;        // what level this bucket is on
 } Bucket;
 
+// where a node sits in the buckets; one per node, kept by SmartQ
+// rather than in Node so the other queues do not carry it
+typedef struct BucketLink {
+   Node *next;           // next in bucket (the nodes form a ring)
+   Node *prev;           // prev in bucket
+   Bucket *bucket;       // our bucket, if where == IN_BUCKETS
+} BucketLink;
+
 typedef struct Level {
   ulong cNodes;         // number of nodes currently stored at this level
   Bucket *rgBin;        // points to the cBuckets buckets at our level
   Bucket *pBucket;      // the current bucket at level i
+  unsigned long long *occupied;  // bit j of word j/64 is set iff
+                        // rgBin[j] is nonempty
   ulong digShift;       // shifting distance and the applying 
   ulong digMask;        // digMask gives the digit
 } Level;
@@ -43,7 +54,8 @@ class SmartQ {
                              // equal to floor of log_2(minArcLen)
    unsigned long long relBitMask;  // bits determining node position
 
-   long long statEmpty;      // statistic: how many empty buckets we scanned
+   long long statEmpty;      // statistic: how many all-empty bitmap words
+                             // we scanned
    long statExpandedNodes;   // statistic: how many nodes we expand out
    long statExpandedBuckets; // statistic: how many buckets we expand out of
    long statInsert;          // statistic: how many Insert operations
@@ -53,22 +65,31 @@ class SmartQ {
    Bucket *DistToBucket(long long *pDist, Level *lev);
 
    Node *SortBucket(Level *pLevel);
+   Bucket *NextBucket(Level *pLevel);
+   ulong Bins(Level *pLevel)   { return pLevel == topLevel ? topDelta : delta; }
 
    Stack *F;
    long long mu;
+   CSRGraph *graph;
+   Node *nodes;              // the labels we search; rgLink and
+                             // rgCaliber are indexed like them
+   BucketLink *rgLink;       // bucket links of each node
+   long long *rgCaliber;     // graph->caliber, only with calibers
+   bool caliber;             // use calibers and F (smart queue); if not
+                             // this is plain multi-level buckets
 
  public:
    SmartQ(long long *pMinArcLen, long long *pMaxArcLen, ulong cLevels, 
-	  ulong logD, long n, Node *nodes);
+	  ulong logD, CSRGraph *graphGiven, Node *nodes, bool useCaliber);
    ~SmartQ();
    void Init();              // resets bucket indices.  Assumes buckets are OK
    void reInit();
-#ifdef SINGLE_PAIR
-   bool dijkstra(Node *source, Node *sink, SP *sp); // run dijkstra's algorithm
-#else
-   void dijkstra(Node *source, SP *sp);            // run dijkstra's algorithm
-#endif
+   // run dijkstra's algorithm over arcs, graph->arcs or graph->arcs32
+   template <bool MLB, bool SinglePair, class Arc>
+   bool dijkstra(Node *source, Node *sink, SP *sp, const Arc *arcs);
    void PrintStats(long tries);
+   ulong Levels()                  { return topLevel - rgLevels + 1; }
+   ulong LogDelta()                { return logDelta; }
 
    Node *Insert(Node *node, Bucket *bckNew);
    Node *Delete(Node *node, Bucket *bckOld);
@@ -6,26 +6,23 @@
 #include "sp.h"
 
 
-#define USE_BINHEAP
-
-void ArcLen(long cNodes, Node *nodes,
+void ArcLen(CSRGraph *graph,
 	    long long *pMin /* = NULL */, long long *pMax /* = NULL */)
 // finds the max arc length and min arc length of a graph.
 // Used to init for buckets.  pMax or pMin can be NULL.  For fun,
 // and utility, returns MaxArcLen.
 {
-   Arc *lastArc, *arc;
-   long long maxLen = 0, minLen = VERY_FAR;
+   long a;
+   long long len, maxLen = 0, minLen = VERY_FAR;
 
-            // arcs are stored sequentially.  The last arc overall
-            // is one before the first arc of the sentinel node.
-   lastArc = (nodes+cNodes)->first - 1;
-   for ( arc = nodes->first; arc <= lastArc; arc++ )
+            // arcs are stored sequentially, in either layout.
+   for ( a = 0; a < graph->m; a++ )
    {
-      if ( arc->len > maxLen )
-	 maxLen = arc->len;
-      if ( arc->len < minLen )
-         minLen = arc->len;
+      len = csr_len(graph, a);
+      if ( len > maxLen )
+	 maxLen = len;
+      if ( len < minLen )
+         minLen = len;
    }
    if ( pMin )   *pMin = minLen;
    if ( pMax )   *pMax = maxLen;
@@ -35,58 +32,57 @@ void ArcLen(long cNodes, Node *nodes,
 //-------------------------------------------------------------
 // SP::SP()
 // SP::~SP()
-//     Each algorithm needs a different data structure.  We add
-//     them all here and then send them in the sp() call.  This
-//     way we need to allocate memory only once even though there
-//     may be many sp calls.  Note that we expect the sp calls
-//     all to be made on the same graph, though info about it
-//     may change.
+//     Each algorithm needs a different data structure.  We build
+//     the engine for the requested queue and mode here and then
+//     use it in the sp() call.  This way we need to allocate
+//     memory only once even though there may be many sp calls.
+//     Note that we expect the sp calls all to be made on the same
+//     graph, though info about it may change.
 //-------------------------------------------------------------
 
-SP::SP(long cNodesGiven, Node *nodesGiven, ulong levels, ulong logDelta,
-       bool doBFS)
+SP::SP(CSRGraph *graphGiven, Node *nodesGiven, int queueType, int mode,
+       SPParams *params, bool doBFS /* = false */)
 {
-  long long minArcLen, maxArcLen;
-
-  cNodes = cNodesGiven;
+  graph = graphGiven;
+  cNodes = graph->n;
   nodes = nodesGiven;
+  parent = new long[cNodes + 1];
   cCalls = cScans = cUpdates = 0;     // no stats yet
   BFSqueue = NULL;
+  engine = NULL;
 
+  spType = queueType;
+  spMode = mode;
 
-  //** initialize data type for new sp algorithm here **//
-
-  //ArcLen(cNodes, nodes, &minArcLen, &maxArcLen);
-  spType = SP_DIK_SMARTQ;
-  
-
-  smartq = NULL;                      // for DIK_SMARTQ
-  fibHeap = NULL;                     // for DIK_FIBOHEAP
-  binHeap = NULL;                     // for DIK_BINHEAP
   if (!doBFS){
-    // smartq = new SmartQ(&minArcLen,
-		// 	&maxArcLen,
-		// 	levels, logDelta,
-		// 	cNodes, nodes);
-#ifdef USE_BINHEAP
-    binHeap = new BinoHeap_Wrapper(cNodes,nodes);
-#else
-    fibHeap = new FiboHeap_Wrapper(cNodes, nodes);
-#endif
+    //** new sp algorithms register in engine.cc **//
+    engine = spNewEngine(spType, spMode, graph, nodes, params);
   }
   else {
-    BFSqueue = new Bucket;
-    BFSqueue->pNode = NULL;
+    BFSqueue = new Node *[cNodes > 0 ? cNodes : 1];
   }
 }
 
+// for another thread: the engine is cloned, sharing its
+// preprocessed data, and searches the labels in nodesGiven
+SP::SP(SP *sp, Node *nodesGiven)
+{
+  graph = sp->graph;
+  cNodes = sp->cNodes;
+  nodes = nodesGiven;
+  parent = new long[cNodes + 1];
+  cCalls = cScans = cUpdates = 0;
+  BFSqueue = NULL;
+  spType = sp->spType;
+  spMode = sp->spMode;
+  engine = sp->engine->Clone(nodes);
+}
+
 SP::~SP()
 {
-   if ( smartq )      delete smartq;
-   if (BFSqueue) delete BFSqueue;
-//** delete data structure for new sp algorithm here **//
-   if (fibHeap) delete fibHeap;
-   if (binHeap) delete binHeap;
+   if (BFSqueue) delete [] BFSqueue;
+   delete [] parent;
+   if (engine) delete engine;
 }
 
 //-------------------------------------------------------------
@@ -98,17 +94,14 @@ void SP::initNode(Node *currentNode)
 {
    currentNode->where = IN_NONE;   // nodes not in any data structure yet
    currentNode->dist = VERY_FAR;   // not yet a shortest path
-   currentNode->sBckInfo.bucket = NULL;
-   currentNode->sBckInfo.next = NULL;
-   currentNode->sBckInfo.prev = NULL;
    currentNode->tStamp = curTime; // 时间标记更新
 }
 
 //-------------------------------------------------------------
 // SP::init()
 //     Initially, all lengths are set to VERY_FAR, presumably
-//     longer than any real distance, and the parent field is
-//     set to NULL to indicate the sp tree does not yet exist.
+//     longer than any real distance.  Parents are only set as
+//     nodes are reached, so the sp tree does not yet exist.
 //-------------------------------------------------------------
 void SP::init()
 {
@@ -123,7 +116,7 @@ void SP::init()
 void SP::initS(Node *source)
 {
   initNode(source);
-  source->parent = source;
+  parent[source - nodes] = source - nodes;
   source->dist = 0;               // all distances are to the source
 }
 
@@ -136,7 +129,7 @@ void SP::BFSInit(Node *source)
    for ( currentNode=nodes, iNode=0; iNode <= cNodes; iNode++, currentNode++ )
    {
       currentNode->dist = VERY_FAR;   // not yet a shortest path
-      currentNode->parent = NULL;
+      parent[iNode] = -1;
    }
 
    source->dist = 0;               // all distances are to the source
@@ -144,31 +137,21 @@ void SP::BFSInit(Node *source)
 
 //-------------------------------------------------------------
 // SP::sp()
-//     Just calls the SP algorithm specified in spType, and returns
-//     the overall stat that the SP algorithm returns.  Actual
-//     code for sp algorithms can be found in their cc files:
-//     dijkstra.cc, etc.
-//        If OPEN is not NULL, we test all arcs with OPEN and
-//     ignore those that aren\'t OPEN.  Otherwise all ARCS are open
-//        If StopAt is not NULL, we do shortest paths only until
-//     we reach a node for which StopAt returns 1 (it may check
-//     for nodes with excess capacity, for instance).  Thus,
-//     only part of the distance tree will be correct, but that
-//     part will include a path from StopAt to a source.
-//        RETURNS the node that StopAt stopped at, or NULL if
-//     StopAt was NULL or no node passed StopAt\'s test.
+//     Runs the engine chosen at construction and returns whether
+//     the sink was reached.  Actual code for sp algorithms can be
+//     found in their cc files: smartq.cc, fiboheap.cc, etc.
+//        If sink is NULL, we compute shortest paths from source to
+//     all nodes.  Otherwise the engine may stop as soon as the
+//     distance to sink is known, so only part of the distance tree
+//     will be correct, but that part will include a path from
+//     source to sink.
 //-------------------------------------------------------------
 
-void SP::sp(Node *source)
+bool SP::sp(Node *source, Node *sink /* = NULL */)
 {
    cCalls++;
 
-   //smartq->dijkstra(source, this);
-#ifdef USE_BINHEAP
-   binHeap->dijkstra(source,this);
-#else
-   fibHeap->dijkstra(source, this);
-#endif
+   return engine->run(source, sink, this);
 }
 //-------------------------------------------------------------
 // SP::PrintStats()
@@ -184,12 +167,7 @@ void SP::PrintStats(long tries)
    fprintf(stderr, "c Scans (ave): %20.1f     Improvements (ave): %10.1f\n", 
 	  (float) cScans / (float) tries, 
 	  (float) cUpdates / (float) tries);
-   //smartq->PrintStats(tries);
-#ifdef USE_BINHEAP
-    binHeap->printfStats();
-#else
-    fibHeap->printfStats();
-#endif
+   engine->PrintStats(tries);
 }
 
 void SP::initStats()
@@ -208,43 +186,34 @@ int SP::nodeId(Node *i)
 
 long SP::BFS(Node *source)
 
+{
+  if (graph->arcs32 != NULL)
+    return BFSArcs(source, graph->arcs32);
+  return BFSArcs(source, graph->arcs);
+}
+
+template <class Arc>
+long SP::BFSArcs(Node *source, const Arc *arcs)
 {
   Node *v, *w;
-  Arc *a, *stopA;
-  long nFound = 0;
+  const Arc *a, *stopA;
+  long head = 0, tail = 0;
 
   BFSInit(source);
-  BFSqueue->pNode = source;
-  source->sBckInfo.next = source->sBckInfo.prev = source;
-  do {
-    nFound++;
-    v = BFSqueue->pNode;
+  BFSqueue[tail++] = source;
+  while (head < tail) {
+    v = BFSqueue[head++];
 
     // scan v
-    stopA = (v+1)->first - 1;
-    for (a = v->first; a <= stopA; a++) {
-      w = a->head;
+    stopA = arcs + graph->first[v - nodes + 1];
+    for (a = arcs + graph->first[v - nodes]; a < stopA; a++) {
+      w = nodes + a->head;
       if (w->dist == VERY_FAR) {
 	w->dist = v->dist + 1;
-	w->parent = v;
-
-	// insert w
-	v->sBckInfo.prev->sBckInfo.next = w;
-	w->sBckInfo.prev = v->sBckInfo.prev;
-	v->sBckInfo.prev = w;
-	w->sBckInfo.next = v;
+	parent[a->head] = v - nodes;
+	BFSqueue[tail++] = w;    // each node is queued once
       }
     }
-
-    // delete v
-    if (v->sBckInfo.next != v) {
-      BFSqueue->pNode = v->sBckInfo.next;
-      v->sBckInfo.next->sBckInfo.prev = v->sBckInfo.prev;
-      v->sBckInfo.prev->sBckInfo.next = v->sBckInfo.next;
-    }
-    else {
-      BFSqueue->pNode = NULL;
-    }
-  } while (BFSqueue->pNode != NULL);
-  return (nFound);
+  }
+  return (tail);
 }
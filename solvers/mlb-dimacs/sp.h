@@ -1,8 +1,9 @@
 // sp.h  by Andrew Goldberg
 //     Started 5/21/01
 //     The main driver for shortest-path routines.  Whenever you want
-//     to use an SP, you include sp.h and call sp::sp with the
-//     algorithm you want, taken from the #defines below.
+//     to use an SP, you include sp.h, construct it with the queue
+//     backend and mode you want (SP_DIK_*, SP_MODE_* in engine.h)
+//     and call sp::sp.
 
 #ifndef SP_H
 #define SP_H
@@ -10,61 +11,62 @@
 #include <stdlib.h>
 #include "values.h"
 #include "nodearc.h"
+#include "csr.h"
 #include "stack.h"
 #include "smartq.h"
+#include "engine.h"
 
 #include "binheap.h"
 #include "fiboheap.h"
+#include "radixheap.h"
+#include "daryheap.h"
+#include "pairheap.h"
 
 #define VERY_FAR            922337203685477 // LLONG_MAX
 #define FAR                 MAXLONG
 
-#define SP_DIK_SMARTQ       1024       // use SP_S_Q + # of levels
-
 #define DIK_BUCKETS_DEFAULT  2         // default of two bucket levels
 
 
-int sp_openarc(Arc *arc);              // whether SP thinks an arc is usable
-extern void ArcLen(long cNodes, Node *nodes,
+extern void ArcLen(CSRGraph *graph,
 		   long long *pMin = NULL, long long *pMax = NULL);
 
 
-class FiboHeap_Wrapper;
-class BinoHeap_Wrapper;
-
 class SP {
  private:
    long cNodes;
 
-   int spType;
+   int spType;                        // SP_DIK_* queue backend
+   int spMode;                        // SP_MODE_*
    void BFSInit(Node *source);
+   template <class Arc>
+   long BFSArcs(Node *source, const Arc *arcs);
 
 
-   //change this node to other data structure.
-   Node *nodes;
+   CSRGraph *graph;                   // shared, read-only adjacency
+   Node *nodes;                       // per-node search state
+   long *parent;                      // parent index of each node in
+                                      // the sp tree; the source's is
+                                      // itself
 
    
-   SmartQ *smartq;                    // for dijkstra_smartq
-   Bucket *BFSqueue;                 // for baseline BSF
-//** add new SP data structure here **//
-   FiboHeap_Wrapper *fibHeap;         // for dijkstra_fibheap
-   BinoHeap_Wrapper *binHeap;          // for dijkstra_binominalheap
+   Node **BFSqueue;                  // for baseline BFS, FIFO
+   SPEngine *engine;                  // queue backend; see engine.cc
 
    
  public:
-   SP(long cNodesGiven, Node *nodesGiven, ulong levels, ulong maxDelta,
-      bool doBFS);
+   SP(CSRGraph *graphGiven, Node *nodesGiven, int queueType, int mode,
+      SPParams *params, bool doBFS = false);
+   SP(SP *sp, Node *nodesGiven);      // same engine on other labels
    ~SP();
    void init();
    void initS(Node *source);
    void initNode(Node *source);
    long getNodeNum(){return cNodes;}
    Node *getNodes(){return nodes;}
-#ifdef SINGLE_PAIR
-   bool sp(Node *source, Node *sink);
-#else
-   void sp(Node *source);
-#endif
+   long *getParents(){return parent;}
+   CSRGraph *getGraph(){return graph;}
+   bool sp(Node *source, Node *sink = NULL);   // sink NULL: one-to-all
    // these must be public, alas, so Heap and Bucket can modify them
    long cCalls;         // # of times SP has been called since initialization
    long long cScans;         // # of nodes SP algorithm has looked at (since init)
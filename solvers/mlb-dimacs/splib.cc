@@ -0,0 +1,225 @@
+// splib.cc
+//     Library interface (see splib.h): SPGraph wraps the CSR graph,
+//     SPQueryContext an SP with its own Node array.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include "splib.h"
+#include "reorder.h"
+
+extern int parse_gr( long *n_ad, long *m_ad, CSRGraph **graph_ad,
+		  char *problem_name );
+extern int parse_co(long nGraph, long **x_array, long **y_array, char *coName);
+
+//-------------------------------------------------------------
+// SPGraph
+//     The compact arcs (where they fit), the reverse graph and the
+//     calibers are built up front: several modes and queues need
+//     them, and adding them later would change a graph other threads
+//     may be reading.
+//-------------------------------------------------------------
+
+SPGraph::SPGraph(const char *grFile, const char *coFile /* = NULL */,
+		 bool lonLat /* = false */, const char *order /* = NULL */)
+{
+  CSRGraph *reordered;
+  long n, m;
+  int method = 0;
+
+  if (order != NULL && (method = reorderFindMethod(order)) == 0) {
+    fprintf(stderr, "ERROR: unknown node order %s\n", order);
+    exit(1);
+  }
+  if (csr_is_bin(grFile))
+    graph = csr_map_bin(grFile);
+  else
+    parse_gr(&n, &m, &graph, (char *) grFile);
+  if (coFile != NULL)
+    parse_co(graph->n, &graph->x, &graph->y, (char *) coFile);
+  graph->lonLat = lonLat;
+  newId = oldId = NULL;
+  if (method != 0) {
+    reordered = reorderGraph(graph, method, &newId, &oldId);
+    csr_free(graph);
+    graph = reordered;
+  }
+  csr_compact(graph);
+  csr_add_reverse(graph);
+  csr_add_calibers(graph);
+}
+
+SPGraph::SPGraph(long n, long m, const long *tails, const long *heads,
+		 const long long *lens)
+{
+  long *t = new long[m + 1], *h = new long[m + 1], i;
+
+  for (i = 0; i < m; i++) {
+    if (tails[i] < 1 || tails[i] > n || heads[i] < 1 || heads[i] > n) {
+      fprintf(stderr, "ERROR: arc %ld: node out of range 1..%ld\n",
+	      i + 1, n);
+      exit(1);
+    }
+    if (lens[i] < 0) {
+      fprintf(stderr, "ERROR: arc %ld: negative length\n", i + 1);
+      exit(1);
+    }
+    t[i] = tails[i] - 1;
+    h[i] = heads[i] - 1;
+  }
+  graph = csr_build_arcs(n, m, t, h, lens);
+  newId = oldId = NULL;
+  delete [] t;
+  delete [] h;
+  csr_compact(graph);
+  csr_add_reverse(graph);
+  csr_add_calibers(graph);
+}
+
+SPGraph::~SPGraph()
+{
+  csr_free(graph);
+  free(newId);
+  free(oldId);
+}
+
+//-------------------------------------------------------------
+// SPQueryContext
+//-------------------------------------------------------------
+
+SPQueryContext::SPQueryContext(const SPGraph *graphGiven, const char *queue,
+			       const char *modeName,
+			       SPParams *params /* = NULL */)
+{
+  SPQueueInfo *q = spFindQueue(queue);
+  SPParams p;
+  long long maxArcLen;
+  double dDist;
+
+  graph = graphGiven;
+  mode = spFindMode(modeName);
+  if (q == NULL) {
+    fprintf(stderr, "ERROR: unknown queue %s\n", queue);
+    exit(1);
+  }
+  if (mode == 0) {
+    fprintf(stderr, "ERROR: unknown mode %s\n", modeName);
+    exit(1);
+  }
+  if (!(q->modes & (1 << mode))) {
+    fprintf(stderr, "ERROR: queue %s does not support mode %s\n",
+	    q->name, modeName);
+    exit(1);
+  }
+
+  if (params)
+    p = *params;
+  else
+    spDefaultParams(&p);
+  // heap keys are the narrowest type that holds any distance, as
+  // in main.cc
+  ArcLen(graph->Csr(), NULL, &maxArcLen);
+  dDist = maxArcLen * (double) (graph->Nodes() - 1);
+  p.wideKeys = (dDist * (mode == SP_MODE_ASTAR || mode == SP_MODE_ALT ?
+			 2 : 1) > (double) INT_MAX);
+
+  nodes = (Node *) calloc(graph->Nodes() + 1, sizeof(Node));
+  if (nodes == NULL) {
+    fprintf(stderr, "ERROR: can't allocate query labels\n");
+    exit(1);
+  }
+  sp = new SP(graph->Csr(), nodes, q->type, mode, &p);
+  sp->init();
+}
+
+SPQueryContext::SPQueryContext(const SPQueryContext *first)
+{
+  graph = first->graph;
+  mode = first->mode;
+  nodes = (Node *) calloc(graph->Nodes() + 1, sizeof(Node));
+  if (nodes == NULL) {
+    fprintf(stderr, "ERROR: can't allocate query labels\n");
+    exit(1);
+  }
+  sp = new SP(first->sp, nodes);
+  sp->init();
+}
+
+SPQueryContext::~SPQueryContext()
+{
+  delete sp;
+  free(nodes);
+}
+
+void SPQueryContext::Check(long v, const char *what)
+{
+  if (v < 1 || v > graph->Nodes()) {
+    fprintf(stderr, "ERROR: %s %ld out of range 1..%ld\n",
+	    what, v, graph->Nodes());
+    exit(1);
+  }
+}
+
+//-------------------------------------------------------------
+// SPQueryContext::Run()
+//     Labels are valid where tStamp is current; the rest is left
+//     over from earlier queries.  Labels are by graph index, results
+//     by node id (SPGraph::Index, Id).
+//-------------------------------------------------------------
+
+bool SPQueryContext::Run(long source, long sink, SPResult *result)
+{
+  Node *s, *t, *v;
+  long long scans = sp->cScans, updates = sp->cUpdates;
+  long *parent = sp->getParents();
+  long i, n = graph->Nodes();
+
+  Check(source, "source");
+  if (sink != 0)
+    Check(sink, "sink");
+  else if (mode != SP_MODE_SS) {
+    fprintf(stderr, "ERROR: mode %s needs a sink\n", spModeName(mode));
+    exit(1);
+  }
+
+  result->source = source;
+  result->sink = sink;
+  result->path.clear();
+  result->distance.clear();
+  result->parent.clear();
+
+  s = nodes + graph->Index(source);
+  sp->initS(s);
+  if (sink != 0) {
+    t = nodes + graph->Index(sink);
+    result->reached = sp->sp(s, t);
+    result->dist = result->reached ? t->dist : VERY_FAR;
+    if (result->reached) {
+      for (v = t; v != s; v = nodes + parent[v - nodes])
+	result->path.push_back(graph->Id(v - nodes));
+      result->path.push_back(source);
+      for (i = 0; i < (long) result->path.size() / 2; i++) {
+	long w = result->path[i];
+	result->path[i] = result->path[result->path.size() - 1 - i];
+	result->path[result->path.size() - 1 - i] = w;
+      }
+    }
+  }
+  else {
+    sp->sp(s);
+    result->reached = true;
+    result->dist = 0;
+    result->distance.assign(n + 1, VERY_FAR);
+    result->parent.assign(n + 1, 0);
+    for (v = nodes; v < nodes + n; v++)
+      if (v->tStamp == sp->curTime) {
+	result->distance[graph->Id(v - nodes)] = v->dist;
+	if (v != s)
+	  result->parent[graph->Id(v - nodes)] = graph->Id(parent[v - nodes]);
+      }
+  }
+
+  result->scans = sp->cScans - scans;
+  result->updates = sp->cUpdates - updates;
+  return result->reached;
+}
@@ -0,0 +1,87 @@
+// splib.h
+//     Library interface to the solvers, for programs that answer
+//     shortest path queries themselves rather than run sp.exe
+//     (link with libsp.a -lm -lpthread).  It has three parts:
+//
+//       SPGraph         the graph, read from DIMACS files or given as
+//                       arc arrays.  It never changes once built, so
+//                       any number of threads may share it.
+//       SPQueryContext  all mutable state of one solver: labels,
+//                       queue and engine, for one queue backend and
+//                       mode.  Use one per thread.  The first one
+//                       does any preprocessing (ALT tables, hierarchy,
+//                       arc flags); the others are made from it and
+//                       share that data, so it must outlive them.
+//       SPResult        what a query found: the distance and path to
+//                       the sink, or the whole tree, and the counts.
+//
+//     Nodes are numbered 1 .. n as in the DIMACS files.  Nothing is
+//     kept in globals, so graphs and contexts can coexist freely.
+//     Errors are reported on stderr and end the program, as in the
+//     rest of the solver.
+
+#ifndef SPLIB_H
+#define SPLIB_H
+
+#include <vector>
+#include "sp.h"
+
+class SPGraph {
+ private:
+   CSRGraph *graph;
+   long *newId, *oldId;       // the node order (reorder.h), or NULL
+ public:
+   // grFile is a .gr file or a binary graph file (csr.h), which is
+   // mapped rather than read; coFile (optional) adds coordinates, for
+   // astar and planar/coords preprocessing, and replaces any the
+   // binary file has.  order (optional) is bfs, rcm or hilbert, to
+   // renumber the nodes for locality; node ids given to and returned
+   // by the contexts stay those of the files.
+   SPGraph(const char *grFile, const char *coFile = NULL,
+	   bool lonLat = false, const char *order = NULL);
+   // arc i goes from tails[i] to heads[i], nodes 1 .. n
+   SPGraph(long n, long m, const long *tails, const long *heads,
+	   const long long *lens);
+   ~SPGraph();
+   long Nodes() const               { return graph->n; }
+   long Arcs() const                { return graph->m; }
+   CSRGraph *Csr() const            { return graph; }
+   // index in Csr() of node v, 1 .. n, and the node at index i
+   long Index(long v) const   { return newId ? newId[v - 1] : v - 1; }
+   long Id(long i) const      { return oldId ? oldId[i] + 1 : i + 1; }
+};
+
+class SPResult {
+ public:
+   long source, sink;         // sink is 0 for one-to-all
+   bool reached;              // sink reached (always true for one-to-all)
+   long long dist;            // to the sink
+   std::vector<long> path;    // source .. sink, if reached
+   // one-to-all only: distance and parent of node v at index v;
+   // VERY_FAR and 0 for unreached nodes, and the source's parent is 0
+   std::vector<long long> distance;
+   std::vector<long> parent;
+   long long scans, updates;  // for this query
+};
+
+class SPQueryContext {
+ private:
+   const SPGraph *graph;
+   Node *nodes;
+   SP *sp;
+   int mode;
+
+   void Check(long v, const char *what);
+ public:
+   // queue and mode are names as for --queue= and --mode=; params
+   // (optional, see engine.h) give the preprocessing options
+   SPQueryContext(const SPGraph *graphGiven, const char *queue,
+		  const char *modeName, SPParams *params = NULL);
+   // another context like first, sharing its preprocessed data
+   SPQueryContext(const SPQueryContext *first);
+   ~SPQueryContext();
+   // sink 0: one-to-all (ss mode only); returns result->reached
+   bool Run(long source, long sink, SPResult *result);
+};
+
+#endif
@@ -31,7 +31,7 @@ private:
 public:
   Stack(long size)        { top = 0;  curr = 0; maxSize = size;
 			    data = new void * [maxSize]; assert(data); }
-  ~Stack()                { delete data; }
+  ~Stack()                { delete [] data; }
   void *Push(void *elt)   { assert(top+1<=maxSize); return (data[top++]=elt); }
   void *Pop()             { assert(top > 0);        return (data[--top]); }
   void Clear()            { top = 0; }
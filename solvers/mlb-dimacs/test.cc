@@ -1,36 +1,259 @@
+// test.cc
+//     Checks the solvers through splib.h: first the small example
+//     graph, then every queue in every mode it supports against a
+//     plain Dijkstra (std::priority_queue) on generated graphs, with
+//     both arc layouts.  "make test" builds and runs it; it exits
+//     with status 1 if any check fails.
 
-#include <iostream>
-
-#include "fiboheap.h"
-#include "sp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <queue>
+#include <vector>
+#include <functional>
+#include "splib.h"
+#include "alt.h"
+#include "arcflags.h"
+#include "dial.h"
 
 using namespace std;
 
-int main(){
-    Node list[] = {{0,NULL,NULL,0,0}, //一个简单的有向图，用于测试
-        {997,NULL,NULL,0,0},
-        {998,NULL,NULL,0,0},
-        {999,NULL,NULL,0,0}};
-    
-    Arc alist[] = {{10,list+1},
-        {60,list+2},
-        {5,list+3},
-        {200,list},
-        {4,list+2}};
-
-    list[0].first = alist; //第一个节点连有两条边，与第二和第三个节点相连
-    list[1].first = alist+2; //第二个节点只与最后一个节点相连
-    list[2].first = alist+3; //第三个节点与一个节点相连
-    list[3].first = alist+4; //第四个节点与第三个节点相连
-
-    for(int q=0;q<4;q++){
-        std::cout<<list[q].dist<<" ";
-    }
-    std::cout<<endl;
-
-    SP *sp = new SP(4,list,1,1,false);
-    sp->sp(list); //以第一个节点为起点
-    
-    sp->PrintStats(0);
+typedef struct TestGraph {
+    long n, m;                         // nodes 1 .. n
+    vector<long> tails, heads;
+    vector<long long> lens;
+    vector<long> x, y;                 // x[v - 1], y[v - 1]
+} TestGraph;
+
+static long failures = 0;
+
+static void fail(const char *what, const char *queue, const char *mode,
+                 long source, long sink)
+{
+    if (failures++ < 20)
+        fprintf(stderr, "FAIL: %s, queue %s, mode %s, %ld -> %ld\n",
+                what, queue, mode, source, sink);
+}
+
+// a side x side grid with coordinates unit apart, arcs both ways
+// between neighbors and some longer arcs at random; every arc is at
+// least as long as the straight line it spans, so the coordinates
+// give A* a feasible bound.  Node n has no arcs at all.
+static void makeGraph(TestGraph *g, long side, long unit, long spread)
+{
+    long r, c, v, w, i;
+    double d;
+
+    g->n = side * side + 1;
+    g->x.resize(g->n);
+    g->y.resize(g->n);
+    for (v = 0; v < g->n; v++) {
+        g->x[v] = (v % side) * unit;
+        g->y[v] = (v / side) * unit;
+    }
+    for (r = 0; r < side; r++)
+        for (c = 0; c < side; c++) {
+            v = r * side + c;
+            if (c + 1 < side) {
+                g->tails.push_back(v + 1); g->heads.push_back(v + 2);
+                g->tails.push_back(v + 2); g->heads.push_back(v + 1);
+            }
+            if (r + 1 < side) {
+                g->tails.push_back(v + 1); g->heads.push_back(v + side + 1);
+                g->tails.push_back(v + side + 1); g->heads.push_back(v + 1);
+            }
+        }
+    for (i = 0; i < side * side / 4; i++) {
+        g->tails.push_back(rand() % (side * side) + 1);
+        g->heads.push_back(rand() % (side * side) + 1);
+    }
+    g->m = (long) g->tails.size();
+    for (i = 0; i < g->m; i++) {
+        v = g->tails[i] - 1;
+        w = g->heads[i] - 1;
+        d = sqrt((double) (g->x[v] - g->x[w]) * (g->x[v] - g->x[w]) +
+                 (double) (g->y[v] - g->y[w]) * (g->y[v] - g->y[w]));
+        g->lens.push_back((long long) ceil(d) + rand() % spread);
+    }
+}
+
+// distances from source, VERY_FAR where unreached
+static void dijkstra(const TestGraph *g, long source, vector<long long> *dist)
+{
+    typedef pair<long long, long> Entry;
+    priority_queue<Entry, vector<Entry>, greater<Entry> > heap;
+    vector<vector<long> > out(g->n + 1);
+    long v, w, i;
+    long long d;
+
+    for (i = 0; i < g->m; i++)
+        out[g->tails[i]].push_back(i);
+    dist->assign(g->n + 1, VERY_FAR);
+    (*dist)[source] = 0;
+    heap.push(Entry(0, source));
+    while (!heap.empty()) {
+        d = heap.top().first;
+        v = heap.top().second;
+        heap.pop();
+        if (d > (*dist)[v])
+            continue;
+        for (i = 0; i < (long) out[v].size(); i++) {
+            w = g->heads[out[v][i]];
+            if (d + g->lens[out[v][i]] < (*dist)[w]) {
+                (*dist)[w] = d + g->lens[out[v][i]];
+                heap.push(Entry((*dist)[w], w));
+            }
+        }
+    }
+}
+
+// whether path is made of arcs of g and as long as dist
+static bool pathOk(const TestGraph *g, const vector<long> &path,
+                   long long dist)
+{
+    long long total = 0, best;
+    long k, i;
+
+    for (k = 0; k + 1 < (long) path.size(); k++) {
+        best = -1;
+        for (i = 0; i < g->m; i++)
+            if (g->tails[i] == path[k] && g->heads[i] == path[k + 1] &&
+                (best < 0 || g->lens[i] < best))
+                best = g->lens[i];
+        if (best < 0)
+            return false;
+        total += best;
+    }
+    return total == dist;
+}
+
+static bool isHeap(int type)
+{
+    return type != SP_DIK_SMARTQ && type != SP_DIK_MLB &&
+        type != SP_DIK_DELTA && type != SP_DIK_DIAL;
+}
+
+// every query of one queue and mode, on the first context and on one
+// made from it
+static void checkMode(const TestGraph *g, const SPGraph *graph,
+                      const vector<vector<long long> > &ref,
+                      const vector<long> &sources, const char *queue,
+                      int mode, bool caliber)
+{
+    SPParams params;
+    SPResult result;
+    const char *name = spModeName(mode);
+    long i, k, v, t;
+
+    spDefaultParams(&params);
+    params.caliber = caliber;
+    params.altMethod = ALT_AVOID;
+    params.altCount = 4;
+    params.chContract = true;
+    params.afMethod = AF_GROW;
+    params.afCells = 8;
+    SPQueryContext first(graph, queue, name, &params);
+    SPQueryContext other(&first);
+
+    for (i = 0; i < (long) sources.size(); i++) {
+        SPQueryContext *context = (i % 2) ? &other : &first;
+        if (mode == SP_MODE_SS) {
+            context->Run(sources[i], 0, &result);
+            for (v = 1; v <= g->n; v++)
+                if (result.distance[v] != ref[i][v]) {
+                    fail("distance", queue, name, sources[i], v);
+                    break;
+                }
+            continue;
+        }
+        for (k = 0; k < 8; k++) {
+            t = k ? rand() % g->n + 1 : g->n;    // node n is unreachable
+            if (context->Run(sources[i], t, &result) !=
+                (ref[i][t] != VERY_FAR) || (result.reached &&
+                (result.dist != ref[i][t] ||
+                 !pathOk(g, result.path, result.dist))))
+                fail("distance or path", queue, name, sources[i], t);
+        }
+    }
+}
+
+static void checkGraph(TestGraph *g, const char *what)
+{
+    SPGraph graph(g->n, g->m, &g->tails[0], &g->heads[0], &g->lens[0]);
+    vector<vector<long long> > ref;
+    vector<long> sources;
+    long long maxArcLen = 0;
+    SPQueueInfo *q;
+    long i;
+    int mode, layout;
+
+    // coordinates, for astar; csr_free() frees them with the graph
+    graph.Csr()->x = (long *) malloc(g->n * sizeof(long));
+    graph.Csr()->y = (long *) malloc(g->n * sizeof(long));
+    for (i = 0; i < g->n; i++) {
+        graph.Csr()->x[graph.Index(i + 1)] = g->x[i];
+        graph.Csr()->y[graph.Index(i + 1)] = g->y[i];
+    }
+    for (i = 0; i < g->m; i++)
+        if (g->lens[i] > maxArcLen)
+            maxArcLen = g->lens[i];
+    for (i = 0; i < 6; i++) {
+        sources.push_back(rand() % (g->n - 1) + 1);
+        ref.push_back(vector<long long>());
+        dijkstra(g, sources[i], &ref[i]);
+    }
+
+    for (layout = 0; layout < 2; layout++) {
+        if (layout)
+            csr_widen(graph.Csr());
+        printf("%s graph, %s arcs\n", what,
+               graph.Csr()->arcs32 != NULL ? "compact" : "wide");
+        for (q = spQueues; q->name != NULL; q++) {
+            if (q->type == SP_DIK_DIAL && maxArcLen >= DIAL_MAX_BUCKETS)
+                continue;
+            for (mode = SP_MODE_SS; mode <= SP_MODE_ARCFLAGS; mode++)
+                if (q->modes & (1 << mode)) {
+                    checkMode(g, &graph, ref, sources, q->name, mode, false);
+                    if (isHeap(q->type) &&
+                        (mode == SP_MODE_SS || mode == SP_MODE_P2P))
+                        checkMode(g, &graph, ref, sources, q->name, mode,
+                                  true);
+                }
+        }
+    }
+}
+
+int main()
+{
+    // a small directed graph
+    long tails[] = {1, 1, 2, 3, 4};
+    long heads[] = {2, 3, 4, 1, 3};
+    long long lens[] = {10, 60, 5, 200, 4};
+    long long expected[] = {0, 10, 19, 15};
+    SPGraph example(4, 5, tails, heads, lens);
+    SPQueryContext context(&example, "fib", "ss");
+    SPResult result;
+    TestGraph shortArcs, longArcs;
+    long v;
+
+    context.Run(1, 0, &result);        // from the first node
+    for (v = 1; v <= 4; v++) {
+        printf("%lld ", result.distance[v]);
+        if (result.distance[v] != expected[v - 1])
+            fail("example distance", "fib", "ss", 1, v);
+    }
+    printf("\n");
+
+    srand(1);
+    makeGraph(&shortArcs, 12, 3, 20);
+    checkGraph(&shortArcs, "short-arc");
+    makeGraph(&longArcs, 12, 10000000, 100000000);
+    checkGraph(&longArcs, "long-arc");
+
+    if (failures > 0) {
+        printf("%ld checks failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
     return 0;
-}
\ No newline at end of file
+}
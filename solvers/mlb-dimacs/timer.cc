@@ -19,3 +19,18 @@ double timer()
   getrusage(0, &r);
   return (double)(r.ru_utime.tv_sec+r.ru_utime.tv_usec/(double)1000000);
 }
+
+/*********************************************************************/
+/*                                                                   */
+/* Elapsed (wall clock) time in seconds, for multithreaded runs      */
+/* where user time adds up over all threads.                         */
+/*                                                                   */
+/*********************************************************************/
+
+double wallTimer()
+{
+  struct timeval t;
+
+  gettimeofday(&t, 0);
+  return (double)(t.tv_sec+t.tv_usec/(double)1000000);
+}